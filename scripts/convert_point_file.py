@@ -0,0 +1,117 @@
+#!/usr/bin/env python
+"""
+Convert an activity map to the point-file format v2 read by
+/Geometry/FullRingInfinity/pointFile (see source/utils/ActivityMapFile.h).
+
+The input can be either a point file in the legacy format (three int32 with
+the number of voxels, three float32 with the lengths and the float32
+cumulative distribution of all the voxels) or a numpy .npy file with the
+3D activity array, in which case the lengths of the grid must be given.
+
+Only the voxels with activity are stored, together with their alias tables.
+
+Usage:
+  convert_point_file.py input.bin output.v2
+  convert_point_file.py input.npy output.v2 --length 300 300 200
+"""
+
+import argparse
+import numpy as np
+
+MAGIC   = b'PETPTV2\0'
+VERSION = 2
+
+
+def read_legacy(filename):
+    with open(filename, 'rb') as f:
+        n = np.fromfile(f, dtype='<i4', count=3)
+        l = np.fromfile(f, dtype='<f4', count=3).astype(np.float64)
+        cdf = np.fromfile(f, dtype='<f4', count=int(np.prod(n)))
+    if cdf.size != np.prod(n):
+        raise ValueError('File shorter than the size given in its header')
+    # Voxel i is chosen when cdf[i] <= u < cdf[i+1]
+    cdf = cdf.astype(np.float64)
+    activity = np.diff(np.append(cdf, 1.))
+    return n, l, np.clip(activity, 0., None)
+
+
+def read_numpy(filename, lengths):
+    activity = np.load(filename).astype(np.float64)
+    if activity.ndim != 3:
+        raise ValueError('Activity array must have three dimensions')
+    if lengths is None:
+        raise ValueError('The lengths of the grid are needed for .npy input')
+    return np.array(activity.shape), np.array(lengths, dtype=np.float64), activity.ravel()
+
+
+def alias_tables(weights):
+    """
+    Alias tables of Walker, built in rounds of numpy operations instead of
+    pairing the entries one by one as in the method of Vose. In each round,
+    the deficits of all the entries below one are laid one after the other
+    and so are the surpluses of the entries above one. Each entry below one
+    takes as alias the entry whose surplus contains the beginning of its
+    deficit. An entry above one that gives away more than its surplus keeps
+    a positive probability and is below one in the next round.
+    """
+    n     = weights.size
+    prob  = weights * n / weights.sum()
+    alias = np.arange(n, dtype=np.uint32)
+
+    small = np.flatnonzero(prob <  1.)
+    large = np.flatnonzero(prob >= 1.)
+    while small.size and large.size:
+        deficit = np.cumsum(1. - prob[small])
+        surplus = np.cumsum(prob[large] - 1.)
+        start   = deficit - (1. - prob[small])
+        j       = np.minimum(np.searchsorted(surplus, start, side='right'),
+                             large.size - 1)
+        alias[small] = large[j]
+
+        given       = np.bincount(j, weights=1. - prob[small], minlength=large.size)
+        prob[large] = prob[large] - given
+
+        small = large[prob[large] <  1.]
+        large = large[prob[large] >= 1.]
+
+    # Entries left are one up to rounding errors
+    left        = np.concatenate([small, large])
+    prob[left]  = 1.
+    alias[left] = left
+    return prob, alias
+
+
+def write_v2(filename, n, l, activity):
+    voxels = np.flatnonzero(activity > 0.).astype(np.uint32)
+    if voxels.size == 0:
+        raise ValueError('No voxel with activity')
+    prob, alias = alias_tables(activity[voxels])
+
+    with open(filename, 'wb') as f:
+        f.write(MAGIC)
+        np.array([VERSION, 0], dtype='<u4').tofile(f)
+        np.array(n, dtype='<i4').tofile(f)
+        np.array([0], dtype='<u4').tofile(f)
+        np.array(l, dtype='<f8').tofile(f)
+        np.array([voxels.size], dtype='<u8').tofile(f)
+        prob  .astype('<f8').tofile(f)
+        alias .astype('<u4').tofile(f)
+        voxels.astype('<u4').tofile(f)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Convert an activity map to the point-file format v2.')
+    parser.add_argument('input')
+    parser.add_argument('output')
+    parser.add_argument('--length', nargs=3, type=float,
+                        help='lengths of the grid along x, y, z in mm (only for .npy input)')
+    args = parser.parse_args()
+
+    if args.input.endswith('.npy'):
+        n, l, activity = read_numpy(args.input, args.length)
+    else:
+        n, l, activity = read_legacy(args.input)
+
+    write_v2(args.output, n, l, activity)
+    print(f'Written {np.count_nonzero(activity > 0.)} voxels with activity '
+          f'out of {activity.size} to {args.output}')
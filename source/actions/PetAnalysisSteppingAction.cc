@@ -30,7 +30,8 @@ using namespace CLHEP;
 
 REGISTER_CLASS(PetAnalysisSteppingAction, G4UserSteppingAction)
 
-PetAnalysisSteppingAction::PetAnalysisSteppingAction(): G4UserSteppingAction()
+PetAnalysisSteppingAction::PetAnalysisSteppingAction():
+  G4UserSteppingAction(), boundary_(0)
 {
   detected = 0;
   not_det = 0;
@@ -75,16 +76,14 @@ void PetAnalysisSteppingAction::UserSteppingAction(const G4Step* step)
   //G4int copy_no = step->GetPostStepPoint()->GetTouchable()->GetReplicaNumber(1);
 
   // Retrieve the pointer to the optical boundary process.
-  // We do this only once per run defining our local pointer as static.
-  static G4OpBoundaryProcess* boundary = 0;
-
-  if (!boundary) { // the pointer is not defined yet
+  // We do this only once per run, storing it in a member.
+  if (!boundary_) { // the pointer is not defined yet
     // Get the list of processes defined for the optical photon
     // and loop through it to find the optical boundary process.
     G4ProcessVector* pv = pdef->GetProcessManager()->GetProcessList();
     for (size_t i=0; i<pv->size(); i++) {
       if ((*pv)[i]->GetProcessName() == "OpBoundary") {
-	boundary = (G4OpBoundaryProcess*) (*pv)[i];
+	boundary_ = (G4OpBoundaryProcess*) (*pv)[i];
 	break;
       }
     }
@@ -93,7 +92,7 @@ void PetAnalysisSteppingAction::UserSteppingAction(const G4Step* step)
   if (step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary) {
 
     // if boundary->GetStatus() == 2 in SiPMpet refraction takes place
-    if (boundary->GetStatus() == Detection) {
+    if (boundary_->GetStatus() == Detection) {
 	detected = detected + 1;
 	double distance =
 	  std::pow(point2->GetPosition().getX() - point1->GetPosition().getX(), 2) +
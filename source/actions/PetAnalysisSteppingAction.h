@@ -22,6 +22,7 @@
 
 class G4Step;
 class G4GenericMessenger;
+class G4OpBoundaryProcess;
 
 class PetAnalysisSteppingAction : public G4UserSteppingAction
 {
@@ -37,6 +38,10 @@ private:
   G4int detected;
   G4int not_det;
 
+  /// Optical boundary process, looked up with the first optical photon.
+  /// It is a member, not a static, so that each thread has its own.
+  G4OpBoundaryProcess* boundary_;
+
   typedef std::map<G4String, int> detectorCounts;
   detectorCounts my_counts;
 };
@@ -2,23 +2,152 @@
 // petalosim | PetNESTStackingAction.cc
 //
 // This is the stacking action needed to use NEST.
+// Optionally, the thermal electrons produced by NEST are not tracked:
+// their drift to the wires of FullRingInfinity is computed analytically
+// and the charge is added directly to the charge sensitive detector.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
 
 #include "PetNESTStackingAction.h"
+#include "PetaloPersistencyManager.h"
+#include "PetaloPhysics.h"
+#include "ChargeSD.h"
 
 #include "nexus/FactoryBase.h"
 
+#include <NESTProc.hh>
+#include <NEST.hh>
+#include <VDetector.hh>
+
+#include <G4GenericMessenger.hh>
+#include <G4RunManager.hh>
+#include <G4VModularPhysicsList.hh>
+#include <G4SDManager.hh>
+#include <G4Track.hh>
+#include <G4Material.hh>
+#include <Randomize.hh>
+
+using namespace CLHEP;
 
 REGISTER_CLASS(PetNESTStackingAction, G4UserStackingAction)
 
-PetNESTStackingAction::PetNESTStackingAction(): NESTStackingAction()
+PetNESTStackingAction::PetNESTStackingAction(): NESTStackingAction(),
+  msg_(0), parametric_(false), drift_vel_(0.),
+  diff_transv_(55.), diff_long_(25.), sd_(0)
 {
+  msg_ = new G4GenericMessenger(this, "/Actions/PetNESTStackingAction/",
+    "Control commands of the NEST stacking action.");
+
+  msg_->DeclareProperty("parametric_drift", parametric_,
+    "If true, the drift of thermal electrons is computed analytically.");
+
+  G4GenericMessenger::Command& vel_cmd =
+    msg_->DeclareProperty("drift_velocity", drift_vel_,
+      "Drift velocity of electrons, in mm/us. If zero, it is computed by NEST.");
+  vel_cmd.SetParameterName("drift_velocity", false);
+  vel_cmd.SetRange("drift_velocity>=0.");
+
+  G4GenericMessenger::Command& dt_cmd =
+    msg_->DeclareProperty("transverse_diffusion", diff_transv_,
+      "Transverse diffusion coefficient of electrons, in cm2/s.");
+  dt_cmd.SetParameterName("transverse_diffusion", false);
+  dt_cmd.SetRange("transverse_diffusion>=0.");
+
+  G4GenericMessenger::Command& dl_cmd =
+    msg_->DeclareProperty("longitudinal_diffusion", diff_long_,
+      "Longitudinal diffusion coefficient of electrons, in cm2/s.");
+  dl_cmd.SetParameterName("longitudinal_diffusion", false);
+  dl_cmd.SetRange("longitudinal_diffusion>=0.");
 }
 
 
 
 PetNESTStackingAction::~PetNESTStackingAction()
 {
+  delete msg_;
+}
+
+
+
+G4ClassificationOfNewTrack
+PetNESTStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (parametric_ &&
+      track->GetDefinition() == NEST::NESTThermalElectron::Definition()) {
+    DriftElectron(track);
+    return fKill;
+  }
+
+  return NESTStackingAction::ClassifyNewTrack(track);
+}
+
+
+
+void PetNESTStackingAction::Initialize(const G4Track* track)
+{
+  sd_ = dynamic_cast<ChargeSD*>
+    (G4SDManager::GetSDMpointer()->FindSensitiveDetector("/WIRE/ChargeDet",
+                                                         false));
+  if (!sd_ || sd_->GetNumberOfWires() == 0)
+    G4Exception("[PetNESTStackingAction]", "Initialize()", FatalException,
+                "Parametric drift needs the wires of FullRingInfinity.");
+
+  if (drift_vel_ == 0.) {
+    const G4VModularPhysicsList* physlist =
+      dynamic_cast<const G4VModularPhysicsList*>
+      (G4RunManager::GetRunManager()->GetUserPhysicsList());
+    const PetaloPhysics* petphys = physlist ?
+      dynamic_cast<const PetaloPhysics*>(physlist->GetPhysics("PetaloPhysics")) : 0;
+    if (!petphys || !petphys->petalo_)
+      G4Exception("[PetNESTStackingAction]", "Initialize()", FatalException,
+                  "NEST detector not found: set the drift velocity by hand.");
+
+    PetaloPersistencyManager* pm = dynamic_cast<PetaloPersistencyManager*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    G4double efield = pm->GetElectricField();
+    G4double density = track->GetMaterial()->GetDensity() / (g/cm3);
+
+    NEST::NESTcalc calc(petphys->petalo_);
+    drift_vel_ = calc.SetDriftVelocity(petphys->petalo_->get_T_Kelvin(),
+                                       density, efield);
+    G4cout << "[PetNESTStackingAction] Drift velocity of electrons: "
+           << drift_vel_ << " mm/us at " << efield << " V/cm" << G4endl;
+  }
+}
+
+
+
+void PetNESTStackingAction::DriftElectron(const G4Track* track)
+{
+  if (!sd_) Initialize(track);
+
+  G4double velocity = drift_vel_ * mm/microsecond;
+  G4double phi, drift_time;
+  DriftToWires(track->GetPosition(), sd_->GetWireRadius(), velocity,
+               phi, drift_time);
+
+  // Diffusion: sigma = sqrt(2 D t)
+  G4double sigma_t = std::sqrt(2. * diff_transv_ * cm2/s * drift_time);
+  G4double sigma_l = std::sqrt(2. * diff_long_ * cm2/s * drift_time);
+
+  phi += G4RandGauss::shoot(0., sigma_t) / sd_->GetWireRadius();
+
+  G4double time = track->GetGlobalTime() + drift_time +
+    G4RandGauss::shoot(0., sigma_l) / velocity;
+
+  G4int wire_id = sd_->FindWire(phi);
+  sd_->AddCharge(wire_id, sd_->GetWirePosition(wire_id), time);
+}
+
+
+
+void PetNESTStackingAction::DriftToWires(const G4ThreeVector& pos,
+                                         G4double wire_radius,
+                                         G4double velocity, G4double& phi,
+                                         G4double& drift_time)
+{
+  // Electrons drift radially to the wires
+  drift_time = std::abs(wire_radius - pos.perp()) / velocity;
+  phi = std::atan2(-pos.x(), pos.y());
 }
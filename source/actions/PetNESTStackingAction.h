@@ -2,6 +2,9 @@
 // petalosim | PetNESTStackingAction.h
 //
 // This is the stacking action needed to use NEST.
+// Optionally, the thermal electrons produced by NEST are not tracked:
+// their drift to the wires of FullRingInfinity is computed analytically
+// and the charge is added directly to the charge sensitive detector.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
@@ -12,6 +15,10 @@
 #include <G4UserStackingAction.hh>
 
 #include <NESTStackingAction.hh>
+#include <G4ThreeVector.hh>
+
+class G4GenericMessenger;
+class ChargeSD;
 
 // General-purpose user stacking action
 
@@ -23,6 +30,29 @@ public:
   /// Destructor
   ~PetNESTStackingAction();
 
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+
+  /// Azimuthal angle (measured from the +y axis, as the wires) and time
+  /// of arrival at a ring of wires of the given radius of an electron
+  /// created at pos, drifting radially without diffusion
+  static void DriftToWires(const G4ThreeVector& pos, G4double wire_radius,
+                           G4double velocity, G4double& phi,
+                           G4double& drift_time);
+
+private:
+  /// Drift a thermal electron to the wires and fill the charge detector
+  void DriftElectron(const G4Track*);
+  /// Find the charge detector and the drift velocity of the electrons
+  void Initialize(const G4Track*);
+
+  G4GenericMessenger* msg_;
+
+  G4bool parametric_;     ///< If true, thermal electrons are not tracked
+  G4double drift_vel_;    ///< Drift velocity in mm/us, from NEST if zero
+  G4double diff_transv_;  ///< Transverse diffusion coefficient, in cm2/s
+  G4double diff_long_;    ///< Longitudinal diffusion coefficient, in cm2/s
+
+  ChargeSD* sd_;
 };
 
 #endif
@@ -0,0 +1,111 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetPhaseSpaceSteppingAction.cc
+//
+// This stepping action writes to a phase-space file all the particles
+// leaving a cylinder centred on the z axis (e.g., just inside the inner
+// radius of the detector) and, optionally, stops them. The file can be
+// replayed with PhaseSpaceGenerator.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetPhaseSpaceSteppingAction.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4Event.hh>
+#include <G4EventManager.hh>
+#include <G4GenericMessenger.hh>
+
+#include <cfloat>
+
+REGISTER_CLASS(PetPhaseSpaceSteppingAction, G4UserSteppingAction)
+
+PetPhaseSpaceSteppingAction::PetPhaseSpaceSteppingAction():
+  G4UserSteppingAction(), msg_(0), filename_("phase_space.psf"),
+  radius_(150. * mm), half_length_(DBL_MAX), kill_(true)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PetPhaseSpaceSteppingAction/",
+    "Control commands of the phase-space stepping action.");
+
+  msg_->DeclareProperty("file", filename_, "Name of the phase-space file.");
+
+  G4GenericMessenger::Command& radius_cmd =
+    msg_->DeclareProperty("radius", radius_, "Radius of the cylinder.");
+  radius_cmd.SetUnitCategory("Length");
+  radius_cmd.SetParameterName("radius", false);
+  radius_cmd.SetRange("radius>0.");
+
+  G4GenericMessenger::Command& length_cmd =
+    msg_->DeclareProperty("half_length", half_length_,
+                          "Half length of the cylinder.");
+  length_cmd.SetUnitCategory("Length");
+  length_cmd.SetParameterName("half_length", false);
+  length_cmd.SetRange("half_length>0.");
+
+  msg_->DeclareProperty("kill", kill_,
+                        "If true, particles are stopped once recorded.");
+}
+
+
+
+PetPhaseSpaceSteppingAction::~PetPhaseSpaceSteppingAction()
+{
+  if (file_.IsOpen())
+    G4cout << "[PetPhaseSpaceSteppingAction] " << file_.GetNumberOfRecords()
+           << " particles written to " << filename_ << G4endl;
+  file_.Close();
+  delete msg_;
+}
+
+
+
+void PetPhaseSpaceSteppingAction::UserSteppingAction(const G4Step* step)
+{
+  const G4ThreeVector& pre_pos  = step->GetPreStepPoint()->GetPosition();
+  const G4ThreeVector& post_pos = step->GetPostStepPoint()->GetPosition();
+
+  // Only particles leaving the cylinder through its lateral surface
+  if (pre_pos.perp2() >= radius_ * radius_ ||
+      post_pos.perp2() < radius_ * radius_) return;
+
+  // Crossing point of the straight step with the cylinder:
+  // |pre + t (post - pre)|_perp = radius, with t in [0, 1]
+  G4ThreeVector d = post_pos - pre_pos;
+  G4double a = d.perp2();
+  G4double b = pre_pos.x() * d.x() + pre_pos.y() * d.y();
+  G4double c = pre_pos.perp2() - radius_ * radius_;
+  G4double t = (-b + std::sqrt(b * b - a * c)) / a;
+  G4ThreeVector pos = pre_pos + t * d;
+
+  if (std::abs(pos.z()) > half_length_) return;
+
+  if (!file_.IsOpen()) file_.OpenForWriting(filename_);
+
+  G4Track* track = step->GetTrack();
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  G4double time = pre->GetGlobalTime() +
+    t * (step->GetPostStepPoint()->GetGlobalTime() - pre->GetGlobalTime());
+  const G4ThreeVector& dir = pre->GetMomentumDirection();
+
+  PhaseSpaceRecord record;
+  record.event_id   = G4EventManager::GetEventManager()->
+    GetConstCurrentEvent()->GetEventID();
+  record.track_id   = track->GetTrackID();
+  record.parent_id  = track->GetParentID();
+  record.pdg_code   = track->GetDefinition()->GetPDGEncoding();
+  record.x          = pos.x() / mm;
+  record.y          = pos.y() / mm;
+  record.z          = pos.z() / mm;
+  record.dx         = dir.x();
+  record.dy         = dir.y();
+  record.dz         = dir.z();
+  record.kin_energy = pre->GetKineticEnergy() / MeV;
+  record.time       = time / ns;
+  file_.Write(record);
+
+  if (kill_)
+    track->SetTrackStatus(fStopAndKill);
+}
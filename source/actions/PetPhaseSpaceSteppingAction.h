@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetPhaseSpaceSteppingAction.h
+//
+// This stepping action writes to a phase-space file all the particles
+// leaving a cylinder centred on the z axis (e.g., just inside the inner
+// radius of the detector) and, optionally, stops them. The file can be
+// replayed with PhaseSpaceGenerator.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PET_PHASE_SPACE_STEPPING_ACTION_H
+#define PET_PHASE_SPACE_STEPPING_ACTION_H
+
+#include "PhaseSpaceFile.h"
+
+#include <G4UserSteppingAction.hh>
+#include <globals.hh>
+
+class G4GenericMessenger;
+class G4Step;
+
+class PetPhaseSpaceSteppingAction: public G4UserSteppingAction
+{
+public:
+  /// Constructor
+  PetPhaseSpaceSteppingAction();
+  /// Destructor
+  ~PetPhaseSpaceSteppingAction();
+
+  virtual void UserSteppingAction(const G4Step*);
+
+private:
+  G4GenericMessenger* msg_;
+
+  G4String filename_;     ///< Name of the phase-space file
+  G4double radius_;       ///< Radius of the cylinder
+  G4double half_length_;  ///< Half length of the cylinder
+  G4bool kill_;           ///< Stop the particles once recorded
+
+  PhaseSpaceFile file_;
+};
+
+#endif
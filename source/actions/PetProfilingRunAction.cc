@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingRunAction.cc
+//
+// Run action to be used with PetProfilingSteppingAction. It prints a
+// message at the beginning and at the end of each run and, at the end,
+// prints the stepping profile of the run and resets its counters.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetProfilingRunAction.h"
+#include "PetProfilingSteppingAction.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <G4Run.hh>
+#include <G4RunManager.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(PetProfilingRunAction, G4UserRunAction)
+
+PetProfilingRunAction::PetProfilingRunAction(): G4UserRunAction()
+{
+}
+
+
+
+PetProfilingRunAction::~PetProfilingRunAction()
+{
+}
+
+
+
+PetProfilingSteppingAction* PetProfilingRunAction::GetSteppingAction() const
+{
+  return dynamic_cast<PetProfilingSteppingAction*>
+    ((G4UserSteppingAction*) G4RunManager::GetRunManager()->GetUserSteppingAction());
+}
+
+
+
+void PetProfilingRunAction::BeginOfRunAction(const G4Run* run)
+{
+  G4cout << "### Run " << run->GetRunID() << " start." << G4endl;
+
+  // The clock is restarted so that the first step
+  // does not include the time since the previous run
+  PetProfilingSteppingAction* stepping = GetSteppingAction();
+  if (stepping)
+    stepping->StartTrack();
+  else
+    G4Exception("[PetProfilingRunAction]", "BeginOfRunAction()", JustWarning,
+                "The stepping action is not PetProfilingSteppingAction: no profile will be printed.");
+}
+
+
+
+void PetProfilingRunAction::EndOfRunAction(const G4Run* run)
+{
+  PetProfilingSteppingAction* stepping = GetSteppingAction();
+  if (stepping) stepping->EndOfRun();
+
+  G4cout << "### Run " << run->GetRunID() << " end." << G4endl;
+}
@@ -0,0 +1,33 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingRunAction.h
+//
+// Run action to be used with PetProfilingSteppingAction. It prints a
+// message at the beginning and at the end of each run and, at the end,
+// prints the stepping profile of the run and resets its counters.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PET_PROFILING_RUN_ACTION_H
+#define PET_PROFILING_RUN_ACTION_H
+
+#include <G4UserRunAction.hh>
+
+class PetProfilingSteppingAction;
+
+class PetProfilingRunAction: public G4UserRunAction
+{
+public:
+  /// Constructor
+  PetProfilingRunAction();
+  /// Destructor
+  ~PetProfilingRunAction();
+
+  virtual void BeginOfRunAction(const G4Run*);
+  virtual void EndOfRunAction(const G4Run*);
+
+private:
+  PetProfilingSteppingAction* GetSteppingAction() const;
+};
+
+#endif
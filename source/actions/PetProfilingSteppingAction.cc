@@ -0,0 +1,191 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingSteppingAction.cc
+//
+// This class counts the number of steps, the step length and the wall time
+// spent in each pair (logical volume, process that limited the step).
+// The counters are indexed by the instance id of the logical volume and by
+// an index given to each process the first time it is seen, so no strings
+// are handled during the run. The time of a step is measured from the end
+// of the previous step of the same track or, for the first step of a track
+// (or of a suspended track that is resumed), from the start of the track,
+// signalled by PetProfilingTrackingAction. The pairs taking the largest time
+// are printed and the counters are reset at the end of each run by
+// PetProfilingRunAction.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetProfilingSteppingAction.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VProcess.hh>
+#include <G4GenericMessenger.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace nexus;
+
+REGISTER_CLASS(PetProfilingSteppingAction, G4UserSteppingAction)
+
+PetProfilingSteppingAction::PetProfilingSteppingAction():
+  G4UserSteppingAction(), top_(20), last_proc_(0), last_proc_index_(-1),
+  last_step_(std::chrono::steady_clock::now())
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PetProfilingSteppingAction/",
+                                "Control commands of the profiling stepping action.");
+  msg_->DeclareProperty("top", top_,
+                        "Number of (volume, process) pairs printed at the end.");
+}
+
+
+
+PetProfilingSteppingAction::~PetProfilingSteppingAction()
+{
+  delete msg_;
+}
+
+
+
+void PetProfilingSteppingAction::StartTrack()
+{
+  last_step_ = std::chrono::steady_clock::now();
+}
+
+
+
+void PetProfilingSteppingAction::EndOfRun()
+{
+  PrintSummary();
+  Reset();
+}
+
+
+
+void PetProfilingSteppingAction::Reset()
+{
+  // Volumes and processes keep their indices from one run to the next
+  for (auto& row: counters_)
+    std::fill(row.begin(), row.end(), Counters{0, 0., 0.});
+  last_step_ = std::chrono::steady_clock::now();
+}
+
+
+
+G4int PetProfilingSteppingAction::VolumeIndex(const G4LogicalVolume* lv)
+{
+  G4int id = lv->GetInstanceID();
+  if (id >= (G4int) volume_names_.size()) {
+    volume_names_.resize(id + 1);
+    counters_.resize(id + 1);
+  }
+  if (volume_names_[id].empty())
+    volume_names_[id] = lv->GetName();
+  return id;
+}
+
+
+
+G4int PetProfilingSteppingAction::ProcessIndex(const G4VProcess* proc)
+{
+  if (proc == last_proc_ && last_proc_index_ >= 0) return last_proc_index_;
+
+  auto it = process_index_.find(proc);
+  G4int index;
+  if (it == process_index_.end()) {
+    index = process_names_.size();
+    process_names_.push_back(proc ? proc->GetProcessName() : G4String("none"));
+    process_index_[proc] = index;
+  } else {
+    index = it->second;
+  }
+
+  last_proc_ = proc;
+  last_proc_index_ = index;
+  return index;
+}
+
+
+
+void PetProfilingSteppingAction::UserSteppingAction(const G4Step* step)
+{
+  // The time of a step is the time since the previous step of the
+  // track or, for its first step, since the track was started
+  auto now = std::chrono::steady_clock::now();
+  G4double dt = std::chrono::duration<G4double>(now - last_step_).count();
+  last_step_ = now;
+
+  const G4LogicalVolume* lv =
+    step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  G4int iv = VolumeIndex(lv);
+  G4int ip = ProcessIndex(step->GetPostStepPoint()->GetProcessDefinedStep());
+
+  std::vector<Counters>& row = counters_[iv];
+  if (ip >= (G4int) row.size())
+    row.resize(ip + 1, Counters{0, 0., 0.});
+
+  Counters& c = row[ip];
+  c.steps++;
+  c.length += step->GetStepLength();
+  c.time   += dt;
+}
+
+
+
+void PetProfilingSteppingAction::PrintSummary() const
+{
+  struct Entry {
+    G4int volume;
+    G4int process;
+    Counters counters;
+  };
+
+  std::vector<Entry> entries;
+  G4double total_time = 0.;
+  G4long total_steps = 0;
+  for (size_t iv=0; iv<counters_.size(); iv++) {
+    for (size_t ip=0; ip<counters_[iv].size(); ip++) {
+      const Counters& c = counters_[iv][ip];
+      if (c.steps == 0) continue;
+      entries.push_back(Entry{(G4int) iv, (G4int) ip, c});
+      total_time  += c.time;
+      total_steps += c.steps;
+    }
+  }
+  if (entries.empty()) return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b)
+            { return a.counters.time > b.counters.time; });
+
+  G4int n = std::min((G4int) entries.size(), top_);
+
+  G4cout << "------------------------------------------------------------\n"
+         << " Stepping profile: " << total_steps << " steps, "
+         << total_time << " s. Top " << n << " (volume, process) pairs:\n"
+         << std::setw(24) << "volume"
+         << std::setw(20) << "process"
+         << std::setw(14) << "steps"
+         << std::setw(14) << "length (mm)"
+         << std::setw(12) << "time (s)"
+         << std::setw(9)  << "time %" << "\n";
+  for (G4int i=0; i<n; i++) {
+    const Entry& e = entries[i];
+    G4double frac = total_time > 0. ? 100. * e.counters.time / total_time : 0.;
+    G4cout << std::setw(24) << volume_names_[e.volume]
+           << std::setw(20) << process_names_[e.process]
+           << std::setw(14) << e.counters.steps
+           << std::setw(14) << e.counters.length / mm
+           << std::setw(12) << e.counters.time
+           << std::setw(9)  << std::setprecision(3) << frac
+           << std::setprecision(6) << "\n";
+  }
+  G4cout << "------------------------------------------------------------"
+         << G4endl;
+}
@@ -0,0 +1,83 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingSteppingAction.h
+//
+// This class counts the number of steps, the step length and the wall time
+// spent in each pair (logical volume, process that limited the step).
+// The counters are indexed by the instance id of the logical volume and by
+// an index given to each process the first time it is seen, so no strings
+// are handled during the run. The time of a step is measured from the end
+// of the previous step of the same track or, for the first step of a track
+// (or of a suspended track that is resumed), from the start of the track,
+// signalled by PetProfilingTrackingAction. The pairs taking the largest time
+// are printed and the counters are reset at the end of each run by
+// PetProfilingRunAction.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PET_PROFILING_STEPPING_ACTION_H
+#define PET_PROFILING_STEPPING_ACTION_H
+
+#include <G4UserSteppingAction.hh>
+#include <globals.hh>
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+class G4Step;
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4VProcess;
+
+class PetProfilingSteppingAction : public G4UserSteppingAction
+{
+public:
+  /// Constructor
+  PetProfilingSteppingAction();
+  /// Destructor
+  ~PetProfilingSteppingAction();
+
+  virtual void UserSteppingAction(const G4Step *);
+
+  /// Restart the clock at the start of a track
+  void StartTrack();
+  /// Print the summary of the run and reset the counters
+  void EndOfRun();
+
+private:
+  /// Aligned so that each entry lies within one cache line
+  struct alignas(32) Counters {
+    G4long   steps;
+    G4double length;
+    G4double time;
+  };
+
+  G4int VolumeIndex(const G4LogicalVolume* lv);
+  G4int ProcessIndex(const G4VProcess* proc);
+  void PrintSummary() const;
+  void Reset();
+
+  G4GenericMessenger* msg_;
+  G4int top_; ///< Number of (volume, process) pairs printed
+
+  /// Counters of each volume (first index) and process (second index).
+  /// Each thread has its own stepping action, hence its own counters.
+  std::vector<std::vector<Counters>> counters_;
+
+  // Names are copied the first time each volume or process is seen,
+  // since the geometry and physics may be deleted before the summary
+  std::vector<G4String> volume_names_;
+  std::vector<G4String> process_names_;
+  std::unordered_map<const G4VProcess*, G4int> process_index_;
+
+  // Last process seen, since consecutive steps are
+  // often limited by the same process
+  const G4VProcess* last_proc_;
+  G4int last_proc_index_;
+
+  /// End of the last step, or start of the current track
+  std::chrono::steady_clock::time_point last_step_;
+};
+
+#endif
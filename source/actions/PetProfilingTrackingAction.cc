@@ -0,0 +1,106 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingTrackingAction.cc
+//
+// Tracking action that stores the trajectories as PetaloTrackingAction
+// and measures the wall time, number of tracks and number of steps spent
+// on each particle species. The profile of each event is saved in the
+// /MC/profile table and a summary is printed at the end of the run.
+// If the stepping action is PetProfilingSteppingAction, its clock is
+// restarted at the start of each track.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetProfilingTrackingAction.h"
+#include "PetaloPersistencyManager.h"
+#include "PetProfilingSteppingAction.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <NESTProc.hh>
+
+#include <G4Track.hh>
+#include <G4RunManager.hh>
+#include <G4GenericMessenger.hh>
+#include <G4Gamma.hh>
+#include <G4Electron.hh>
+#include <G4Positron.hh>
+#include <G4OpticalPhoton.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(PetProfilingTrackingAction, G4UserTrackingAction)
+
+PetProfilingTrackingAction::PetProfilingTrackingAction():
+  PetaloTrackingAction(), stepping_(0), stepping_found_(false),
+  species_(TrackProfile::kOther)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PetProfilingTrackingAction/",
+                                "Control commands of the profiling tracking action.");
+  msg_->DeclareMethod("save_table", &PetProfilingTrackingAction::SetSaveTable,
+                      "If true, the profile of each event is saved to file.");
+
+  species_def_[TrackProfile::kGamma]    = G4Gamma::Definition();
+  species_def_[TrackProfile::kElectron] = G4Electron::Definition();
+  species_def_[TrackProfile::kPositron] = G4Positron::Definition();
+  species_def_[TrackProfile::kOpticalPhoton]   = G4OpticalPhoton::Definition();
+  species_def_[TrackProfile::kThermalElectron] =
+    NEST::NESTThermalElectron::Definition();
+
+  PetaloPersistencyManager* pm = dynamic_cast<PetaloPersistencyManager*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm) pm->SetTrackProfile(&profile_);
+}
+
+
+
+PetProfilingTrackingAction::~PetProfilingTrackingAction()
+{
+  delete msg_;
+}
+
+
+
+void PetProfilingTrackingAction::SetSaveTable(G4bool save)
+{
+  profile_.SetSaveTable(save);
+}
+
+
+
+void PetProfilingTrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  const G4ParticleDefinition* def = track->GetDefinition();
+  species_ = TrackProfile::kOther;
+  for (G4int i=0; i<TrackProfile::kOther; i++) {
+    if (def == species_def_[i]) {
+      species_ = i;
+      break;
+    }
+  }
+
+  PetaloTrackingAction::PreUserTrackingAction(track);
+
+  // The user actions are all set before the first track
+  if (!stepping_found_) {
+    stepping_ = dynamic_cast<PetProfilingSteppingAction*>
+      ((G4UserSteppingAction*) G4RunManager::GetRunManager()->GetUserSteppingAction());
+    stepping_found_ = true;
+  }
+  if (stepping_) stepping_->StartTrack();
+
+  // Tracks are never nested: the time between the two calls
+  // is the time spent stepping this track
+  start_ = std::chrono::steady_clock::now();
+}
+
+
+
+void PetProfilingTrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  std::chrono::duration<G4double> elapsed =
+    std::chrono::steady_clock::now() - start_;
+  profile_.AddTrack(species_, elapsed.count(), track->GetCurrentStepNumber());
+
+  PetaloTrackingAction::PostUserTrackingAction(track);
+}
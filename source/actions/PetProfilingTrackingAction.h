@@ -0,0 +1,54 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetProfilingTrackingAction.h
+//
+// Tracking action that stores the trajectories as PetaloTrackingAction
+// and measures the wall time, number of tracks and number of steps spent
+// on each particle species. The profile of each event is saved in the
+// /MC/profile table and a summary is printed at the end of the run.
+// If the stepping action is PetProfilingSteppingAction, its clock is
+// restarted at the start of each track.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PET_PROFILING_TRACKING_ACTION_H
+#define PET_PROFILING_TRACKING_ACTION_H
+
+#include "PetaloTrackingAction.h"
+#include "TrackProfile.h"
+
+#include <chrono>
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class PetProfilingSteppingAction;
+
+class PetProfilingTrackingAction : public PetaloTrackingAction
+{
+public:
+  /// Constructor
+  PetProfilingTrackingAction();
+  /// Destructor
+  virtual ~PetProfilingTrackingAction();
+
+  virtual void PreUserTrackingAction(const G4Track *);
+  virtual void PostUserTrackingAction(const G4Track *);
+
+private:
+  void SetSaveTable(G4bool save);
+
+  G4GenericMessenger* msg_;
+  TrackProfile profile_;
+
+  // Particle definitions, compared by pointer
+  const G4ParticleDefinition* species_def_[TrackProfile::kOther];
+
+  /// Profiling stepping action, if any, looked up with the first track
+  PetProfilingSteppingAction* stepping_;
+  G4bool stepping_found_;
+
+  G4int species_; ///< species of the track being tracked
+  std::chrono::steady_clock::time_point start_;
+};
+
+#endif
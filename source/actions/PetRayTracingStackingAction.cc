@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetRayTracingStackingAction.cc
+//
+// This stacking action replaces the Geant4 tracking of the optical photons
+// created in the LXe of FullRingInfinity with the analytic transport of
+// RingRayTracer. Photons are collected in batches and traced when the urgent
+// stack is empty, or when the batch is full.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetRayTracingStackingAction.h"
+#include "FullRingInfinity.h"
+#include "RingRayTracer.h"
+#include "ToFSD.h"
+
+#include "nexus/DetectorConstruction.h"
+#include "nexus/FactoryBase.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4RunManager.hh>
+#include <G4SDManager.hh>
+#include <G4Track.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(PetRayTracingStackingAction, G4UserStackingAction)
+
+PetRayTracingStackingAction::PetRayTracingStackingAction():
+  G4UserStackingAction(), msg_(0), tracer_(0), sd_(0),
+  batch_size_(1000000), waiting_token_(false), flushing_(false)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PetRayTracingStackingAction/",
+    "Control commands of the ray-tracing stacking action.");
+
+  G4GenericMessenger::Command& batch_cmd =
+    msg_->DeclareProperty("batch_size", batch_size_,
+                          "Maximum number of photons traced together.");
+  batch_cmd.SetParameterName("batch_size", false);
+  batch_cmd.SetRange("batch_size>0");
+}
+
+
+
+PetRayTracingStackingAction::~PetRayTracingStackingAction()
+{
+  delete msg_;
+}
+
+
+
+G4ClassificationOfNewTrack
+PetRayTracingStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (track->GetDefinition() != G4OpticalPhoton::Definition())
+    return fUrgent;
+
+  // Photons outside the LXe between the sensors are tracked by Geant4
+  if (!tracer_->Contains(track->GetPosition()))
+    return fUrgent;
+
+  if (!flushing_ && !waiting_token_) {
+    waiting_token_ = true;
+    return fWaiting;
+  }
+
+  tracer_->AddPhoton(track->GetPosition(), track->GetMomentumDirection(),
+                     track->GetKineticEnergy(), track->GetGlobalTime(),
+                     track->GetTrackID());
+
+  if (!flushing_ && (G4int)tracer_->GetNumberOfPhotons() >= batch_size_)
+    Trace();
+
+  return fKill;
+}
+
+
+
+void PetRayTracingStackingAction::NewStage()
+{
+  // Move the photon kept in the waiting stack to the batch
+  flushing_ = true;
+  stackManager->ReClassify();
+  flushing_ = false;
+  waiting_token_ = false;
+
+  Trace();
+}
+
+
+
+void PetRayTracingStackingAction::PrepareNewEvent()
+{
+  if (!tracer_) {
+    DetectorConstruction* detconst = (DetectorConstruction*)
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction();
+    FullRingInfinity* geom =
+      dynamic_cast<FullRingInfinity*>(detconst->GetGeometry());
+    if (!geom || !geom->GetRayTracer())
+      G4Exception("[PetRayTracingStackingAction]", "PrepareNewEvent()",
+                  FatalException,
+                  "Ray tracing is only available for FullRingInfinity without separators.");
+    tracer_ = geom->GetRayTracer();
+
+    sd_ = dynamic_cast<ToFSD*>
+      (G4SDManager::GetSDMpointer()->FindSensitiveDetector("/SIPM/SiPMpetVUV"));
+    if (!sd_)
+      G4Exception("[PetRayTracingStackingAction]", "PrepareNewEvent()",
+                  FatalException, "SiPMpetVUV sensitive detector not found.");
+  }
+
+  tracer_->Clear();
+  waiting_token_ = false;
+  flushing_ = false;
+}
+
+
+
+void PetRayTracingStackingAction::Trace()
+{
+  tracer_->Trace(sd_);
+}
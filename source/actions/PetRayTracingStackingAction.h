@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetRayTracingStackingAction.h
+//
+// This stacking action replaces the Geant4 tracking of the optical photons
+// created in the LXe of FullRingInfinity with the analytic transport of
+// RingRayTracer. Photons are collected in batches and traced when the urgent
+// stack is empty, or when the batch is full.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PET_RAY_TRACING_STACKING_ACTION_H
+#define PET_RAY_TRACING_STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+
+class G4GenericMessenger;
+class RingRayTracer;
+class ToFSD;
+
+class PetRayTracingStackingAction : public G4UserStackingAction
+{
+public:
+  /// Constructor
+  PetRayTracingStackingAction();
+  /// Destructor
+  ~PetRayTracingStackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+  virtual void NewStage();
+  virtual void PrepareNewEvent();
+
+private:
+  void Trace();
+
+  G4GenericMessenger* msg_;
+
+  RingRayTracer* tracer_;
+  ToFSD* sd_;
+
+  G4int batch_size_; ///< maximum number of photons traced together
+
+  /// One photon of each batch is kept in the waiting stack, so that
+  /// NewStage() is invoked once the rest of the event has been tracked
+  G4bool waiting_token_;
+  G4bool flushing_;
+};
+
+#endif
@@ -31,6 +31,10 @@ public:
   /// Hook at the end of the event loop
   void EndOfEventAction(const G4Event *);
 
+  /// Energy window of the events saved
+  G4double GetMinEnergy() const;
+  G4double GetMaxEnergy() const;
+
 private:
   G4GenericMessenger *msg_;
   G4int nevt_, nupdate_;
@@ -39,4 +43,7 @@ private:
   G4int min_charge_;
 };
 
+inline G4double PetSensorsEventAction::GetMinEnergy() const { return min_energy_; }
+inline G4double PetSensorsEventAction::GetMaxEnergy() const { return max_energy_; }
+
 #endif
@@ -31,6 +31,10 @@ public:
   /// Hook at the end of the event loop
   void EndOfEventAction(const G4Event *);
 
+  /// Energy window of the events saved
+  G4double GetMinEnergy() const;
+  G4double GetMaxEnergy() const;
+
 private:
   G4GenericMessenger *msg_;
   G4int nevt_, nupdate_;
@@ -38,4 +42,7 @@ private:
   G4double max_energy_;
 };
 
+inline G4double PetaloEventAction::GetMinEnergy() const { return min_energy_; }
+inline G4double PetaloEventAction::GetMaxEnergy() const { return max_energy_; }
+
 #endif
@@ -0,0 +1,404 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetaloStackingAction.cc
+//
+// This stacking action postpones the tracking of optical photons until
+// all the other particles of the event have been tracked. If the energy
+// deposited in the ionization sensitive detectors is outside the energy
+// window of the event action (PetaloEventAction or PetSensorsEventAction)
+// at that point, the event will not be saved and the optical photons are
+// discarded without being tracked.
+// Optical photons can also be killed when they are created, depending on
+// the volume or region where they are produced, or on their creator process.
+// A rule is a set of conditions that must all hold. Photons matching a kill
+// rule are killed. If there are keep rules, the photons matching none of
+// them are killed too. At the end of each run, the photons killed by each
+// rule are printed per logical volume where they were created.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PetaloStackingAction.h"
+#include "PetaloEventAction.h"
+#include "PetSensorsEventAction.h"
+#include "PetIonizationSD.h"
+
+#include "nexus/IonizationHit.h"
+#include "nexus/FactoryBase.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4Track.hh>
+#include <G4Event.hh>
+#include <G4EventManager.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4SDManager.hh>
+#include <G4HCtable.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4RegionStore.hh>
+#include <G4ProcessTable.hh>
+#include <G4StateManager.hh>
+#include <G4VProcess.hh>
+
+#include <sstream>
+
+using namespace nexus;
+
+REGISTER_CLASS(PetaloStackingAction, G4UserStackingAction)
+
+namespace {
+  void PrintPerVolume(const std::map<const G4LogicalVolume*, G4long>& counts)
+  {
+    for (auto& c: counts)
+      G4cout << "[PetaloStackingAction]   in "
+             << (c.first ? c.first->GetName() : G4String("(no volume)"))
+             << ": " << c.second << G4endl;
+  }
+
+  G4long Total(const std::map<const G4LogicalVolume*, G4long>& counts)
+  {
+    G4long total = 0;
+    for (auto& c: counts) total += c.second;
+    return total;
+  }
+}
+
+
+
+PetaloStackingAction::PetaloStackingAction():
+  G4UserStackingAction(), G4VStateDependent(), msg_(0), evt_action_(0),
+  sns_evt_action_(0), evt_action_found_(false),
+  first_stage_(true), n_rejected_(0), resolved_(false)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PetaloStackingAction/",
+    "Control commands of the PETALO stacking action.");
+
+  msg_->DeclareMethod("kill_volume", &PetaloStackingAction::KillVolume,
+    "Kill the optical photons created in the logical volume(s) with this name.");
+  msg_->DeclareMethod("kill_region", &PetaloStackingAction::KillRegion,
+    "Kill the optical photons created in this region.");
+  msg_->DeclareMethod("kill_process", &PetaloStackingAction::KillProcess,
+    "Kill the optical photons created by this process (e.g., Cerenkov).");
+  msg_->DeclareMethod("kill", &PetaloStackingAction::Kill,
+    "Kill the optical photons fulfilling all the conditions of the rule, "
+    "e.g. 'volume:ACTIVE process:Cerenkov'. Names are resolved at the first event.");
+  msg_->DeclareMethod("keep", &PetaloStackingAction::Keep,
+    "Kill the optical photons fulfilling none of the keep rules, "
+    "e.g. 'volume:ACTIVE process:Scintillation'. Names are resolved at the first event.");
+}
+
+
+
+PetaloStackingAction::~PetaloStackingAction()
+{
+  delete msg_;
+}
+
+
+
+G4bool PetaloStackingAction::Notify(G4ApplicationState requested_state)
+{
+  // A run ends when the state goes back from GeomClosed to Idle
+  if (requested_state == G4State_Idle &&
+      G4StateManager::GetStateManager()->GetCurrentState() == G4State_GeomClosed)
+    PrintStatistics();
+  return true;
+}
+
+
+
+void PetaloStackingAction::PrintStatistics()
+{
+  G4cout << "[PetaloStackingAction] Optical photons not tracked in "
+         << n_rejected_ << " events." << G4endl;
+  for (auto& rule: kill_rules_) {
+    G4cout << "[PetaloStackingAction] Optical photons killed by rule '"
+           << rule.text << "': " << Total(rule.n_killed) << G4endl;
+    PrintPerVolume(rule.n_killed);
+    rule.n_killed.clear();
+  }
+  if (!keep_rules_.empty()) {
+    G4cout << "[PetaloStackingAction] Optical photons killed by the keep rules: "
+           << Total(n_not_kept_) << G4endl;
+    PrintPerVolume(n_not_kept_);
+    n_not_kept_.clear();
+  }
+  n_rejected_ = 0;
+}
+
+
+
+G4ClassificationOfNewTrack
+PetaloStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (track->GetDefinition() != G4OpticalPhoton::Definition())
+    return fUrgent;
+
+  if ((!kill_rules_.empty() || !keep_rules_.empty()) && KillPhoton(track))
+    return fKill;
+
+  if (first_stage_)
+    return fWaiting;
+
+  return fUrgent;
+}
+
+
+
+G4bool PetaloStackingAction::KillPhoton(const G4Track* track)
+{
+  // Primary photons have no volume yet
+  const G4VPhysicalVolume* pvol = track->GetVolume();
+  const G4LogicalVolume* lvol = pvol ? pvol->GetLogicalVolume() : 0;
+  const G4VProcess* proc = track->GetCreatorProcess();
+
+  for (auto& rule: kill_rules_) {
+    if (Matches(rule, lvol, proc)) {
+      rule.n_killed[lvol]++;
+      return true;
+    }
+  }
+
+  if (keep_rules_.empty()) return false;
+
+  for (auto& rule: keep_rules_)
+    if (Matches(rule, lvol, proc)) return false;
+
+  n_not_kept_[lvol]++;
+  return true;
+}
+
+
+
+G4bool PetaloStackingAction::Matches(const Rule& rule,
+                                     const G4LogicalVolume* lvol,
+                                     const G4VProcess* proc) const
+{
+  for (auto& c: rule.conditions) {
+    G4bool match = false;
+    if (c.type == "volume") {
+      for (auto v: c.volumes)
+        if (v == lvol) match = true;
+    }
+    else if (c.type == "region") {
+      match = lvol && c.region && lvol->GetRegion() == c.region;
+    }
+    else {
+      for (auto p: c.procs)
+        if (p == proc) match = true;
+    }
+    if (!match) return false;
+  }
+
+  return true;
+}
+
+
+
+void PetaloStackingAction::KillVolume(G4String name)
+{
+  AddRule(kill_rules_, "volume:" + name);
+}
+
+
+
+void PetaloStackingAction::KillRegion(G4String name)
+{
+  AddRule(kill_rules_, "region:" + name);
+}
+
+
+
+void PetaloStackingAction::KillProcess(G4String name)
+{
+  AddRule(kill_rules_, "process:" + name);
+}
+
+
+
+void PetaloStackingAction::Kill(G4String rule)
+{
+  AddRule(kill_rules_, rule);
+}
+
+
+
+void PetaloStackingAction::Keep(G4String rule)
+{
+  AddRule(keep_rules_, rule);
+}
+
+
+
+void PetaloStackingAction::AddRule(std::vector<Rule>& rules,
+                                   const G4String& text)
+{
+  Rule rule;
+  rule.text = text;
+
+  std::istringstream tokens(text);
+  std::string token;
+  while (tokens >> token) {
+    size_t colon = token.find(':');
+    Condition c;
+    c.type = token.substr(0, colon);
+    c.region = 0;
+    if (colon == std::string::npos || colon + 1 == token.size() ||
+        (c.type != "volume" && c.type != "region" && c.type != "process")) {
+      G4String msg = "Wrong condition '" + token + "' in rule '" + text +
+        "': expected volume:<name>, region:<name> or process:<name>.";
+      G4Exception("[PetaloStackingAction]", "AddRule()",
+                  FatalErrorInArgument, msg);
+    }
+    c.name = token.substr(colon + 1);
+    rule.conditions.push_back(c);
+  }
+
+  if (rule.conditions.empty())
+    G4Exception("[PetaloStackingAction]", "AddRule()",
+                FatalErrorInArgument, "Empty rule for optical photons.");
+
+  rules.push_back(rule);
+  resolved_ = false;
+}
+
+
+
+void PetaloStackingAction::ResolveFilters()
+{
+  for (auto rules: {&kill_rules_, &keep_rules_}) {
+    for (auto& rule: *rules) {
+      for (auto& c: rule.conditions) {
+        c.volumes.clear();
+        c.procs.clear();
+        G4bool found = false;
+
+        if (c.type == "volume") {
+          // Several logical volumes may share the same name
+          G4LogicalVolumeStore* lvs = G4LogicalVolumeStore::GetInstance();
+          for (auto it = lvs->begin(); it != lvs->end(); ++it) {
+            if ((*it)->GetName() == c.name) {
+              c.volumes.push_back(*it);
+              found = true;
+            }
+          }
+        }
+        else if (c.type == "region") {
+          c.region = G4RegionStore::GetInstance()->GetRegion(c.name, false);
+          found = (c.region != 0);
+        }
+        else {
+          G4ProcessVector* procs =
+            G4ProcessTable::GetProcessTable()->FindProcesses(c.name);
+          for (size_t j=0; j<procs->size(); j++) {
+            c.procs.push_back((*procs)[j]);
+            found = true;
+          }
+          delete procs;
+        }
+
+        if (!found) {
+          G4String msg = "No " + c.type + " named " + c.name + " in rule '" +
+            rule.text + "': no optical photon will fulfill it.";
+          G4Exception("[PetaloStackingAction]", "ResolveFilters()",
+                      JustWarning, msg);
+        }
+      }
+    }
+  }
+
+  resolved_ = true;
+}
+
+
+
+void PetaloStackingAction::NewStage()
+{
+  // All the particles but the optical photons have been tracked
+  if (!first_stage_) return;
+  first_stage_ = false;
+
+  G4double min_energy, max_energy;
+  if (!EnergyWindow(min_energy, max_energy)) return;
+
+  // Same energy selection as the EndOfEventAction() of the event actions.
+  // PetSensorsEventAction also requires a minimum detected charge,
+  // which is only known once the optical photons are tracked.
+  G4double edep = EnergyDeposit();
+  if (edep <= min_energy || edep >= max_energy) {
+    // The event will not be saved: discard the optical photons
+    // in the waiting stack before they are transported
+    stackManager->clear();
+    n_rejected_++;
+  }
+}
+
+
+
+void PetaloStackingAction::PrepareNewEvent()
+{
+  first_stage_ = true;
+
+  // The window is read from the event action, so that both always agree
+  if (!evt_action_found_) {
+    const G4UserEventAction* action =
+      G4EventManager::GetEventManager()->GetUserEventAction();
+    evt_action_     = dynamic_cast<const PetaloEventAction*>(action);
+    sns_evt_action_ = dynamic_cast<const PetSensorsEventAction*>(action);
+    evt_action_found_ = true;
+    if (!evt_action_ && !sns_evt_action_)
+      G4Exception("[PetaloStackingAction]", "PrepareNewEvent()", JustWarning,
+                  "The event action is neither PetaloEventAction nor PetSensorsEventAction: optical photons will be tracked in all events.");
+  }
+
+  if (!resolved_)
+    ResolveFilters();
+}
+
+
+
+G4bool PetaloStackingAction::EnergyWindow(G4double& min_energy,
+                                          G4double& max_energy) const
+{
+  if (evt_action_) {
+    min_energy = evt_action_->GetMinEnergy();
+    max_energy = evt_action_->GetMaxEnergy();
+    return true;
+  }
+  if (sns_evt_action_) {
+    min_energy = sns_evt_action_->GetMinEnergy();
+    max_energy = sns_evt_action_->GetMaxEnergy();
+    return true;
+  }
+  return false;
+}
+
+
+
+G4double PetaloStackingAction::EnergyDeposit() const
+{
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if (!hce) return 0.;
+
+  G4SDManager* sdmgr = G4SDManager::GetSDMpointer();
+  G4HCtable* hct = sdmgr->GetHCtable();
+
+  G4double edep = 0.;
+  for (int i=0; i<hct->entries(); i++) {
+    G4String hcname = hct->GetHCname(i);
+    if (hcname != PetIonizationSD::GetCollectionUniqueName()) continue;
+
+    G4String sdname = hct->GetSDname(i);
+    int hcid = sdmgr->GetCollectionID(sdname+"/"+hcname);
+    IonizationHitsCollection* hits =
+      dynamic_cast<IonizationHitsCollection*>(hce->GetHC(hcid));
+    if (!hits) continue;
+
+    for (size_t j=0; j<hits->entries(); j++)
+      edep += (*hits)[j]->GetEnergyDeposit();
+  }
+
+  return edep;
+}
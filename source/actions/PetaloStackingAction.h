@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------------
+// petalosim | PetaloStackingAction.h
+//
+// This stacking action postpones the tracking of optical photons until
+// all the other particles of the event have been tracked. If the energy
+// deposited in the ionization sensitive detectors is outside the energy
+// window of the event action (PetaloEventAction or PetSensorsEventAction)
+// at that point, the event will not be saved and the optical photons are
+// discarded without being tracked.
+// Optical photons can also be killed when they are created, depending on
+// the volume or region where they are produced, or on their creator process.
+// A rule is a set of conditions that must all hold, such as "the photon is
+// created in ACTIVE by Scintillation". Photons matching a kill rule are
+// killed. If there are keep rules, the photons matching none of them are
+// killed too. The names of the rules are resolved at the beginning of the
+// first event after they are given, not at the beginning of the run.
+// At the end of each run, the photons killed by each rule are printed per
+// logical volume where they were created.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PETALO_STACKING_ACTION_H
+#define PETALO_STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+#include <G4VStateDependent.hh>
+
+#include <map>
+#include <vector>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4Region;
+class G4VProcess;
+class PetaloEventAction;
+class PetSensorsEventAction;
+
+class PetaloStackingAction : public G4UserStackingAction,
+                             public G4VStateDependent
+{
+public:
+  /// Constructor
+  PetaloStackingAction();
+  /// Destructor
+  ~PetaloStackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+  virtual void NewStage();
+  virtual void PrepareNewEvent();
+
+  /// Print and reset the counters at the end of each run
+  G4bool Notify(G4ApplicationState requested_state) override;
+
+  /// Kill the optical photons created in the logical volumes with this name
+  void KillVolume(G4String name);
+  /// Kill the optical photons created in this region
+  void KillRegion(G4String name);
+  /// Kill the optical photons created by this process
+  void KillProcess(G4String name);
+  /// Kill the optical photons matching a rule, given as a list
+  /// of conditions "volume:<name>", "region:<name>" or "process:<name>"
+  void Kill(G4String rule);
+  /// Kill the optical photons that match none of the keep rules
+  void Keep(G4String rule);
+
+private:
+  /// Condition of a rule on the place of creation or creator process
+  struct Condition {
+    G4String type; ///< volume, region or process
+    G4String name;
+    std::vector<G4LogicalVolume*> volumes;
+    G4Region* region;
+    std::vector<const G4VProcess*> procs;
+  };
+
+  struct Rule {
+    G4String text;
+    std::vector<Condition> conditions;
+    /// Photons killed by the rule (kill rules only),
+    /// per logical volume where they were created
+    std::map<const G4LogicalVolume*, G4long> n_killed;
+  };
+
+  /// Energy deposited so far in the ionization sensitive detectors
+  G4double EnergyDeposit() const;
+  /// Energy window of the event action. False if it has none.
+  G4bool EnergyWindow(G4double& min_energy, G4double& max_energy) const;
+  /// Parse a rule and add it to the given list
+  void AddRule(std::vector<Rule>& rules, const G4String& text);
+  /// Find the volumes, regions and processes of the rules
+  void ResolveFilters();
+  /// Whether the photon fulfills all the conditions of a rule
+  G4bool Matches(const Rule&, const G4LogicalVolume*, const G4VProcess*) const;
+  /// Whether the photon must be killed, counting it
+  G4bool KillPhoton(const G4Track*);
+  /// Print the counters of the run and reset them
+  void PrintStatistics();
+
+  G4GenericMessenger* msg_;
+
+  /// Event action whose energy window is applied, if any
+  const PetaloEventAction* evt_action_;
+  const PetSensorsEventAction* sns_evt_action_;
+  G4bool evt_action_found_;
+
+  G4bool first_stage_; ///< true until optical photons are released
+
+  G4int n_rejected_; ///< number of events whose photons were discarded
+
+  std::vector<Rule> kill_rules_;
+  std::vector<Rule> keep_rules_;
+  /// Photons matching none of the keep rules, per logical volume
+  std::map<const G4LogicalVolume*, G4long> n_not_kept_;
+  /// Whether the names of the rules have been resolved
+  /// (at the beginning of the first event after a change)
+  G4bool resolved_;
+};
+
+#endif
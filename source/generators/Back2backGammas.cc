@@ -5,12 +5,16 @@
 // The non-collinearity of the momenta and the Doppler shift of the energy
 // are taken into account. The first gamma is generated with random direction,
 // by default. However, it is possible to specify a limited solid angle.
+// Optionally, the annihilation point is displaced from the decay vertex
+// according to the positron range of the isotope, without tracking
+// the positron.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
 
 #include "Back2backGammas.h"
 #include "PetaloUtils.h"
+#include "PositronRangeKernel.h"
 
 #include "nexus/RandomUtils.h"
 #include "nexus/DetectorConstruction.h"
@@ -21,17 +25,22 @@
 #include <G4GenericMessenger.hh>
 #include <G4RunManager.hh>
 #include <G4ParticleTable.hh>
+#include <G4Gamma.hh>
 #include <G4RandomDirection.hh>
 #include <Randomize.hh>
+#include <G4SystemOfUnits.hh>
 
 using namespace CLHEP;
 using namespace nexus;
 
 REGISTER_CLASS(Back2backGammas, G4VPrimaryGenerator)
 
-Back2backGammas::Back2backGammas(): geom_(0), costheta_min_(-1.),
+Back2backGammas::Back2backGammas(): geom_(0), gamma_(G4Gamma::Definition()),
+                                    costheta_min_(-1.),
                                     costheta_max_(1.),
-                                    phi_min_(0.), phi_max_(2.*pi)
+                                    phi_min_(0.), phi_max_(2.*pi),
+                                    isotope_(""), range_file_(""),
+                                    range_kernel_(0)
 {
   //G4cout << "Limits = " << std::numeric_limits<unsigned int>::max() << G4endl;
   msg_ = new G4GenericMessenger(this, "/Generator/Back2back/",
@@ -48,6 +57,10 @@ Back2backGammas::Back2backGammas(): geom_(0), costheta_min_(-1.),
                         "Minimum phi for the direction of the particle.");
   msg_->DeclareProperty("max_phi", phi_max_,
                         "Maximum phi for the direction of the particle.");
+  msg_->DeclareProperty("isotope", isotope_,
+    "Isotope whose positron range displaces the annihilation point (F18, C11, N13, O15, Ga68, Rb82, Na22).");
+  msg_->DeclareProperty("positron_range_file", range_file_,
+    "Text file with the radial density (mm, density) of the positron range.");
 
   DetectorConstruction* detconst =
     (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
@@ -56,13 +69,11 @@ Back2backGammas::Back2backGammas(): geom_(0), costheta_min_(-1.),
 
 Back2backGammas::~Back2backGammas()
 {
+  delete range_kernel_;
 }
 
 void Back2backGammas::GeneratePrimaryVertex(G4Event* evt)
 {
-  G4ParticleDefinition* gamma =
-    G4ParticleTable::GetParticleTable()->FindParticle("gamma");
-
   auto dir1 = (costheta_min_ != -1. || costheta_max_ != 1. || phi_min_ != 0. ||
                phi_max_ != 2.*pi) ?
     RandomDirectionInRange(costheta_min_, costheta_max_, phi_min_, phi_max_):
@@ -74,11 +85,27 @@ void Back2backGammas::GeneratePrimaryVertex(G4Event* evt)
   auto p2 = e2 * dir2;
 
   G4ThreeVector position = geom_->GenerateVertex(region_);
+
+  // The kernel is built with the first event, once the
+  // configuration macros have been read
+  if (!range_kernel_ && (isotope_ != "" || range_file_ != "")) {
+    range_kernel_ = new PositronRangeKernel();
+    if (range_file_ != "")
+      range_kernel_->ReadTable(range_file_);
+    else
+      range_kernel_->SetIsotope(isotope_);
+    G4cout << "Positron range kernel with mean range "
+           << range_kernel_->GetMeanRange() / mm << " mm and maximum range "
+           << range_kernel_->GetMaxRange() / mm << " mm." << G4endl;
+  }
+  if (range_kernel_)
+    position += range_kernel_->SampleDisplacement();
+
   G4double time = 0.;
   auto vertex = new G4PrimaryVertex(position, time);
 
-  vertex->SetPrimary(new G4PrimaryParticle(gamma,  p1.x(),  p1.y(),  p1.z()));
-  vertex->SetPrimary(new G4PrimaryParticle(gamma, -p2.x(), -p2.y(), -p2.z()));
+  vertex->SetPrimary(new G4PrimaryParticle(gamma_,  p1.x(),  p1.y(),  p1.z()));
+  vertex->SetPrimary(new G4PrimaryParticle(gamma_, -p2.x(), -p2.y(), -p2.z()));
 
   evt->AddPrimaryVertex(vertex);
 }
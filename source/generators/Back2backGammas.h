@@ -5,6 +5,9 @@
 // The non-collinearity of the momenta and the Doppler shift of the energy
 // are taken into account. The first gamma is generated with random direction,
 // by default. However, it is possible to specify a limited solid angle.
+// Optionally, the annihilation point is displaced from the decay vertex
+// according to the positron range of the isotope, without tracking
+// the positron.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
@@ -16,6 +19,8 @@
 
 class G4Event;
 class G4GenericMessenger;
+class G4ParticleDefinition;
+class PositronRangeKernel;
 
 namespace nexus { class GeometryBase; }
 
@@ -33,6 +38,7 @@ private:
   
   G4GenericMessenger* msg_;
   const nexus::GeometryBase* geom_;
+  G4ParticleDefinition* gamma_; ///< Cached definition of the gamma
   
   G4String region_;
   
@@ -40,6 +46,10 @@ private:
   G4double costheta_max_;
   G4double phi_min_;
   G4double phi_max_;
+
+  G4String isotope_;    ///< isotope whose positron range is applied
+  G4String range_file_; ///< file with a tabulated positron range kernel
+  PositronRangeKernel* range_kernel_;
 };
 
 //}// end namespace nexus
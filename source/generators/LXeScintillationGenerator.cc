@@ -27,14 +27,22 @@
 #include <G4MaterialPropertiesTable.hh>
 #include <Randomize.hh>
 
+#include <memory>
+
 using namespace nexus;
 using namespace CLHEP;
 
 REGISTER_CLASS(LXeScintillationGenerator, G4VPrimaryGenerator)
 
+namespace {
+  // Number of points of the tabulated inverse of the CDF
+  const G4int n_inv_cdf = 4096;
+}
+
 
 LXeScintillationGenerator::LXeScintillationGenerator() :
-  G4VPrimaryGenerator(), msg_(0), geom_(0), nphotons_(100000)
+  G4VPrimaryGenerator(), msg_(0), geom_(0), nphotons_(100000),
+  builder_(G4OpticalPhoton::Definition())
 {
   msg_ = new G4GenericMessenger(this, "/Generator/LXeScintGenerator/",
     "Control commands of LXe scintillation generator.");
@@ -48,6 +56,7 @@ LXeScintillationGenerator::LXeScintillationGenerator() :
     (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
   geom_ = detconst->GetGeometry();
 
+  BuildInverseCDF();
 }
 
 LXeScintillationGenerator::~LXeScintillationGenerator()
@@ -58,50 +67,20 @@ LXeScintillationGenerator::~LXeScintillationGenerator()
 
 void LXeScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
 {
-  G4ParticleDefinition* particle_definition = G4OpticalPhoton::Definition();
-
   // Generate an initial position for the particle using the geometry
   G4ThreeVector position = geom_->GenerateVertex(region_);
   // Particle generated at start-of-event
   G4double time = 0.;
 
-  // Energy is sampled from integral (like it is
-  // done in G4Scintillation)
-  G4MaterialPropertiesTable* mpt = opticalprops::LXe();
-  // Using fast or slow component here is irrelevant, since we're not using
-  // time and they're the same in energy.
-  G4MaterialPropertyVector* spectrum =
-    mpt->GetProperty("SCINTILLATIONCOMPONENT1");
-  G4PhysicsOrderedFreeVector* spectrum_integral =
-      new G4PhysicsOrderedFreeVector();
-  ComputeCumulativeDistribution(*spectrum, *spectrum_integral);
-  G4double sc_max = spectrum_integral->GetMaxValue();
+  // Energies of all the photons of the event, sampled at once
+  SampleEnergies(nphotons_, energies_);
 
   // Create a new vertex
   G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
 
-  for ( G4int i = 0; i<nphotons_; i++)
-    {
-      // Generate random direction by default
-      G4ThreeVector momentum_direction_ = G4RandomDirection();
-      // Determine photon energy
-      G4double sc_value = G4UniformRand()*sc_max;
-      G4double pmod = spectrum_integral->GetEnergy(sc_value);
-
-      G4double px = pmod * momentum_direction_.x();
-      G4double py = pmod * momentum_direction_.y();
-      G4double pz = pmod * momentum_direction_.z();
-
-      // Create the new primary particle and set it some properties
-      G4PrimaryParticle* particle =
-        new G4PrimaryParticle(particle_definition, px, py, pz);
+  // Random directions and polarizations, built in one pass
+  builder_.AddIsotropic(vertex, energies_, true);
 
-      G4ThreeVector polarization = G4RandomDirection();
-      particle->SetPolarization(polarization);
-
-      // Add particle to the vertex and this to the event
-      vertex->SetPrimary(particle);
-    }
   event->AddPrimaryVertex(vertex);
 }
 
@@ -119,3 +98,46 @@ void LXeScintillationGenerator::ComputeCumulativeDistribution(
     cdf.InsertValues(pdf.Energy(i), sum);
   }
 }
+
+
+void LXeScintillationGenerator::BuildInverseCDF()
+{
+  // Energy is sampled from integral (like it is
+  // done in G4Scintillation). The table is built only once, since
+  // the spectrum does not change during the run.
+  std::unique_ptr<G4MaterialPropertiesTable> mpt(opticalprops::LXe());
+  // Using fast or slow component here is irrelevant, since we're not using
+  // time and they're the same in energy.
+  G4MaterialPropertyVector* spectrum =
+    mpt->GetProperty("SCINTILLATIONCOMPONENT1");
+  G4PhysicsOrderedFreeVector spectrum_integral;
+  ComputeCumulativeDistribution(*spectrum, spectrum_integral);
+  G4double sc_max = spectrum_integral.GetMaxValue();
+
+  inv_cdf_.resize(n_inv_cdf);
+  for (G4int i=0; i<n_inv_cdf; i++) {
+    G4double sc_value = sc_max * i / (n_inv_cdf - 1);
+    inv_cdf_[i] = spectrum_integral.GetEnergy(sc_value);
+  }
+}
+
+
+void LXeScintillationGenerator::SampleEnergies(
+  G4int n, std::vector<G4double>& energies) const
+{
+  energies.resize(n);
+  if (n == 0) return;
+
+  // Random numbers for the whole batch, then linear interpolation
+  // of the tabulated inverse of the CDF
+  G4Random::getTheEngine()->flatArray(n, energies.data());
+
+  const G4double scale = n_inv_cdf - 1;
+  for (G4int i=0; i<n; i++) {
+    G4double x = energies[i] * scale;
+    G4int j = (G4int)x;
+    if (j >= n_inv_cdf - 1) j = n_inv_cdf - 2;
+    G4double f = x - j;
+    energies[i] = inv_cdf_[j] + f * (inv_cdf_[j+1] - inv_cdf_[j]);
+  }
+}
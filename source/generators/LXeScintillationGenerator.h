@@ -11,9 +11,13 @@
 #ifndef LXESCINTILLATIONGENERATOR_H
 #define LXESCINTILLATIONGENERATOR_H
 
+#include "PrimaryVertexBuilder.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4PhysicsOrderedFreeVector.hh>
 
+#include <vector>
+
 class G4GenericMessenger;
 class G4Event;
 
@@ -36,6 +40,11 @@ namespace nexus { class GeometryBase; }
 
     void ComputeCumulativeDistribution(const G4PhysicsOrderedFreeVector&,
                                        G4PhysicsOrderedFreeVector&);
+    /// Tabulate the inverse of the cumulative distribution of the
+    /// LXe scintillation spectrum on a uniform grid of probabilities
+    void BuildInverseCDF();
+    /// Fill the vector with n photon energies sampled from the spectrum
+    void SampleEnergies(G4int n, std::vector<G4double>& energies) const;
 
     G4GenericMessenger* msg_;
     const nexus::GeometryBase* geom_; ///< Pointer to the detector geometry
@@ -43,6 +52,10 @@ namespace nexus { class GeometryBase; }
     G4String region_;
     G4int    nphotons_;
 
+    std::vector<G4double> inv_cdf_;  ///< energy at uniform steps of the CDF
+    std::vector<G4double> energies_; ///< energies of the photons of an event
+    PrimaryVertexBuilder builder_;   ///< Builder of the optical photons
+
   };
 
 #endif
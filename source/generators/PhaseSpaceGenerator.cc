@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+// petalosim | PhaseSpaceGenerator.cc
+//
+// This generator replays a phase-space file written by
+// PetPhaseSpaceSteppingAction: each event contains, as primary particles,
+// all the particles recorded for one event of the original run.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhaseSpaceGenerator.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <G4Event.hh>
+#include <G4GenericMessenger.hh>
+#include <G4ParticleTable.hh>
+#include <G4IonTable.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4PrimaryParticle.hh>
+
+using namespace CLHEP;
+
+REGISTER_CLASS(PhaseSpaceGenerator, G4VPrimaryGenerator)
+
+PhaseSpaceGenerator::PhaseSpaceGenerator(): filename_(""), has_next_(false)
+{
+  msg_ = new G4GenericMessenger(this, "/Generator/PhaseSpace/",
+    "Control commands of the phase-space generator.");
+
+  msg_->DeclareProperty("file", filename_,
+                        "Name of the phase-space file to replay.");
+}
+
+PhaseSpaceGenerator::~PhaseSpaceGenerator()
+{
+  delete msg_;
+}
+
+void PhaseSpaceGenerator::GeneratePrimaryVertex(G4Event* evt)
+{
+  if (!file_.IsOpen()) {
+    file_.OpenForReading(filename_);
+    has_next_ = file_.Read(next_);
+  }
+
+  if (!has_next_) {
+    G4Exception("[PhaseSpaceGenerator]", "GeneratePrimaryVertex()",
+                RunMustBeAborted, "Reached end of phase-space file.");
+    return;
+  }
+
+  G4ParticleTable* ptable = G4ParticleTable::GetParticleTable();
+
+  // All the consecutive records with the same event ID
+  G4int event_id = next_.event_id;
+  while (has_next_ && next_.event_id == event_id) {
+    G4ParticleDefinition* pdef = ptable->FindParticle(next_.pdg_code);
+    if (!pdef)
+      pdef = G4IonTable::GetIonTable()->GetIon(next_.pdg_code);
+    if (!pdef) {
+      G4Exception("[PhaseSpaceGenerator]", "GeneratePrimaryVertex()",
+                  JustWarning, "Unknown particle in phase-space file.");
+    } else {
+      auto vertex =
+        new G4PrimaryVertex(G4ThreeVector(next_.x, next_.y, next_.z) * mm,
+                            next_.time * ns);
+      auto particle = new G4PrimaryParticle(pdef);
+      particle->SetKineticEnergy(next_.kin_energy * MeV);
+      particle->SetMomentumDirection(G4ThreeVector(next_.dx, next_.dy,
+                                                   next_.dz).unit());
+      vertex->SetPrimary(particle);
+      evt->AddPrimaryVertex(vertex);
+    }
+    has_next_ = file_.Read(next_);
+  }
+}
@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// petalosim | PhaseSpaceGenerator.h
+//
+// This generator replays a phase-space file written by
+// PetPhaseSpaceSteppingAction: each event contains, as primary particles,
+// all the particles recorded for one event of the original run.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHASE_SPACE_GENERATOR_H
+#define PHASE_SPACE_GENERATOR_H
+
+#include "PhaseSpaceFile.h"
+
+#include <G4VPrimaryGenerator.hh>
+
+class G4Event;
+class G4GenericMessenger;
+
+class PhaseSpaceGenerator: public G4VPrimaryGenerator
+{
+public:
+  //Constructor
+  PhaseSpaceGenerator();
+  //Destructor
+  ~PhaseSpaceGenerator();
+
+  void GeneratePrimaryVertex(G4Event* evt);
+
+private:
+  G4GenericMessenger* msg_;
+
+  G4String filename_;
+
+  PhaseSpaceFile file_;
+  PhaseSpaceRecord next_; ///< first record of the next event
+  G4bool has_next_;
+};
+
+#endif
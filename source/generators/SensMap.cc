@@ -9,6 +9,7 @@
 // ----------------------------------------------------------------------------
 
 #include "SensMap.h"
+#include "FullRingInfinity.h"
 
 #include "nexus/DetectorConstruction.h"
 #include "nexus/GeometryBase.h"
@@ -23,6 +24,7 @@
 #include <G4RandomDirection.hh>
 #include <Randomize.hh>
 #include <G4OpticalPhoton.hh>
+#include <G4Gamma.hh>
 
 using namespace nexus;
 using namespace CLHEP;
@@ -30,7 +32,8 @@ using namespace CLHEP;
 REGISTER_CLASS(SensMap, G4VPrimaryGenerator)
 
 SensMap::SensMap():
-  G4VPrimaryGenerator(), msg_(0), num_gammas_(1)
+  G4VPrimaryGenerator(), msg_(0), num_gammas_(1),
+  builder_(G4Gamma::Definition())
 {
   msg_ = new G4GenericMessenger(this, "/Generator/SensMap/",
     "Control commands of the sensitivity map primary generator.");
@@ -55,46 +58,23 @@ void SensMap::GeneratePrimaryVertex(G4Event* event)
 {
   // Select an initial position for the gammas using the geometry
   G4ThreeVector position = geom_->GenerateVertex("SENSITIVITY");
+
+  // Events beyond the sensitivity points of this job are aborted without
+  // primaries, so that they are neither simulated nor saved
+  const FullRingInfinity* ring = dynamic_cast<const FullRingInfinity*>(geom_);
+  if (ring && ring->GetSensitivityPoint() < 0) {
+    event->SetEventAborted();
+    return;
+  }
+
   // Gammas generated at start-of-event
   G4double time = 0.;
   // Create a new vertex
   G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
 
 
-  G4ParticleDefinition* particle_definition =
-    G4ParticleTable::GetParticleTable()->FindParticle("gamma");
-  // Set masses to PDG values
-  G4double mass = particle_definition->GetPDGMass();
-  // Set charges to PDG value
-  G4double charge = particle_definition->GetPDGCharge();
-
-  // Calculate cartesian components of momentum
-  G4double energy = 510.999*keV + mass;
-  G4double pmod = std::sqrt(energy*energy - mass*mass);
-
   // Add as many gamma pairs to the vertex as requested by the user
-  for (G4int i=0; i<num_gammas_; i++) {
-
-    G4ThreeVector momentum_direction = G4RandomDirection();
-    G4double px = pmod * momentum_direction.x();
-    G4double py = pmod * momentum_direction.y();
-    G4double pz = pmod * momentum_direction.z();
-
-    G4PrimaryParticle* particle1 =
-      new G4PrimaryParticle(particle_definition, px, py, pz);
-    particle1->SetMass(mass);
-    particle1->SetCharge(charge);
-    particle1->SetPolarization(0.,0.,0.);
-    vertex->SetPrimary(particle1);
-
-    G4PrimaryParticle* particle2 =
-      new G4PrimaryParticle(particle_definition, -px, -py, -pz);
-    particle2->SetMass(mass);
-    particle2->SetCharge(charge);
-    particle2->SetPolarization(0.,0.,0.);
-    vertex->SetPrimary(particle2);
-
-  }
+  builder_.AddBackToBack(vertex, num_gammas_, 510.999*keV);
 
   // Add vertex to the event
   event->AddPrimaryVertex(vertex);
@@ -11,6 +11,8 @@
 #ifndef SENSITIVITY_MAP_GENERATOR_H
 #define SENSITIVITY_MAP_GENERATOR_H
 
+#include "PrimaryVertexBuilder.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -37,6 +39,8 @@ namespace nexus { class GeometryBase; }
     const nexus::GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4int num_gammas_;
+
+    PrimaryVertexBuilder builder_; ///< Builder of the gamma pairs
   };
 
 #endif
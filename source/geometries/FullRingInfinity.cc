@@ -9,10 +9,16 @@
 
 #include "FullRingInfinity.h"
 #include "SiPMpetVUV.h"
+#include "SiPMRingParameterisation.h"
 #include "PetOpticalMaterialProperties.h"
 #include "PetIonizationSD.h"
 #include "ChargeSD.h"
 #include "JaszczakPhantom.h"
+#include "VoxelizedPhantom.h"
+#include "RingRayTracer.h"
+#include "VoxelPointSampler.h"
+#include "ActivityMapFile.h"
+#include "PetaloPersistencyManager.h"
 
 #include "nexus/SpherePointSampler.h"
 #include "nexus/Visibilities.h"
@@ -27,6 +33,7 @@
 #include <G4Material.hh>
 #include <G4LogicalVolume.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4NistManager.hh>
 #include <G4VisAttributes.hh>
 #include <G4LogicalVolume.hh>
@@ -49,6 +56,10 @@ FullRingInfinity::FullRingInfinity() :
   instr_faces_(2),
   charge_det_(false),
   separators_(false),
+  param_sensors_(false),
+  smartless_lxe_(2.),
+  smartless_active_(2.),
+  optimise_(true),
   wire_pitch_(4. * mm),
   wire_time_bin_(1.*microsecond),
   chdet_thickn_(1.*micrometer),
@@ -68,18 +79,28 @@ FullRingInfinity::FullRingInfinity() :
   n_sep_phi_(10),
   specific_vertex_{},
   phantom_(false),
-  pt_Lx_(0.),
-  pt_Ly_(0.),
-  pt_Lz_(0.),
+  vox_phantom_(false),
+  pt_sampler_(0),
+  pt_file_(0),
   sensitivity_(false),
   events_per_point_(1),
   sensitivity_point_id_(0),
   sensitivity_index_(0),
+  sensitivity_current_point_(-1),
   sensitivity_binning_(1 * mm),
+  job_id_(0),
+  num_jobs_(1),
+  sens_first_(0),
+  sens_last_(0),
   sens_x_min_(-inner_radius_),
   sens_x_max_(inner_radius_),
   sens_y_min_(-inner_radius_),
-  sens_y_max_(inner_radius_)
+  sens_y_max_(inner_radius_),
+  lut_(false),
+  lut_binning_(5. * mm),
+  lut_index_(0),
+  tracer_(0),
+  sipm_param_(0)
 {
   // Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/FullRingInfinity/",
@@ -110,8 +131,18 @@ FullRingInfinity::FullRingInfinity() :
                         "True if charge is detected");
   msg_->DeclareProperty("separators", separators_,
                         "True if separator panels are present");
+  msg_->DeclareProperty("parameterised_sensors", param_sensors_,
+                        "True if SiPMs are placed as a single parameterised volume");
   msg_->DeclareProperty("phantom", phantom_,
                         "True if Jaszczak phantom is used");
+  msg_->DeclareProperty("smartless_lxe", smartless_lxe_,
+                        "Smartless of the navigation voxels of the LXe volume");
+  msg_->DeclareProperty("smartless_active", smartless_active_,
+                        "Smartless of the navigation voxels of the active volume");
+  msg_->DeclareProperty("optimisation", optimise_,
+                        "True if the LXe and active volumes are voxelised for navigation");
+  msg_->DeclareProperty("voxelized_phantom", vox_phantom_,
+                        "True if a phantom from medical images is used");
 
   G4GenericMessenger::Command& wire_pitch_cmd =
       msg_->DeclareProperty("wire_pitch", wire_pitch_, "Pitch of wires");
@@ -149,10 +180,32 @@ FullRingInfinity::FullRingInfinity() :
   msg_->DeclareProperty("sensitivity", sensitivity_,
                         "True if sensitivity map is being run");
   msg_->DeclareProperty("sensitivity_point_id", sensitivity_point_id_,
-                        "Starting point for sensitivity run");
+                        "Starting point (within the job) for sensitivity run");
   msg_->DeclareProperty("events_per_point", events_per_point_,
                         "Number of events to be generated per point");
 
+  G4GenericMessenger::Command &job_id_cmd =
+      msg_->DeclareProperty("job_id", job_id_,
+                            "Index of this job in a partitioned sensitivity run");
+  job_id_cmd.SetParameterName("job_id", false);
+  job_id_cmd.SetRange("job_id>=0");
+
+  G4GenericMessenger::Command &num_jobs_cmd =
+      msg_->DeclareProperty("num_jobs", num_jobs_,
+                            "Number of jobs of a partitioned sensitivity run");
+  num_jobs_cmd.SetParameterName("num_jobs", false);
+  num_jobs_cmd.SetRange("num_jobs>0");
+
+  msg_->DeclareProperty("lut", lut_,
+                        "True if a light-response table is being generated");
+
+  G4GenericMessenger::Command &lut_bin_cmd =
+      msg_->DeclareProperty("lut_binning", lut_binning_,
+                            "Pitch of the voxels of the light-response table");
+  lut_bin_cmd.SetUnitCategory("Length");
+  lut_bin_cmd.SetParameterName("lut_binning", false);
+  lut_bin_cmd.SetRange("lut_binning>0.");
+
   G4GenericMessenger::Command &sns_x_min_cmd =
       msg_->DeclareProperty("sens_x_min", sens_x_min_,
                             "Minimum x for sensitivity map");
@@ -190,11 +243,18 @@ FullRingInfinity::FullRingInfinity() :
   sns_z_max_cmd.SetParameterName("sens_z_max", false);
 
   sipm_ = new SiPMpetVUV();
+
+  // Created here so that its commands can be used in configuration macros
+  vox_phantom_geom_ = new VoxelizedPhantom();
 }
 
 FullRingInfinity::~FullRingInfinity()
 {
-  delete[] pt_;
+  delete pt_sampler_;
+  delete pt_file_;
+  delete tracer_;
+  delete vox_phantom_geom_;
+  delete sipm_param_;
 }
 
 void FullRingInfinity::Construct()
@@ -218,12 +278,22 @@ void FullRingInfinity::Construct()
 	  << external_radius_/mm << G4endl;
 
   sipm_->SetSensorDepth(1);
+  // The copy numbers of a parameterised volume start at 0
+  if (param_sensors_)
+    sipm_->SetIdOffset(1000);
   sipm_->Construct();
   sipm_dim_ = sipm_->GetDimensions();
   G4cout << "SiPM size = " << sipm_dim_ << G4endl;
 
   BuildCryostat();
-  BuildSensors();
+  if (param_sensors_)
+    BuildParameterisedSensors();
+  else
+    BuildSensors();
+
+  // The analytic optical transport does not describe the separators
+  if (!(charge_det_ && separators_))
+    BuildRayTracer();
 
   if (charge_det_) {
     if (separators_) {
@@ -236,8 +306,20 @@ void FullRingInfinity::Construct()
   if (phantom_)
     BuildPhantom();
 
+  if (vox_phantom_)
+    BuildVoxelizedPhantom();
+
   if (sensitivity_)
     CalculateSensitivityVertices(sensitivity_binning_);
+
+  if (lut_)
+    CalculateLUTVertices(lut_binning_);
+
+  // Navigation settings of the volumes with many daughters
+  LXe_logic_->SetSmartless(smartless_lxe_);
+  LXe_logic_->SetOptimisation(optimise_);
+  active_logic_->SetSmartless(smartless_active_);
+  active_logic_->SetOptimisation(optimise_);
   }
 
 void FullRingInfinity::BuildCryostat()
@@ -305,7 +387,9 @@ void FullRingInfinity::BuildCryostat()
       new G4Tubs("LXE", lxe_int_radius, lxe_ext_radius,
                  lxe_width/2., 0, twopi);
     LXe_ = G4NistManager::Instance()->FindOrBuildMaterial("G4_lXe");
-    LXe_->SetMaterialPropertiesTable(opticalprops::LXe());
+    LXe_->SetMaterialPropertiesTable(
+      petopticalprops::Memoize("nexus::LXe", {},
+                               [] { return opticalprops::LXe(); }));
     LXe_logic_ =
       new G4LogicalVolume(LXe_solid, LXe_, "LXE");
     new G4PVPlacement(0, G4ThreeVector(0., 0., 0.), LXe_logic_,
@@ -490,6 +574,71 @@ void FullRingInfinity::BuildSensors()
   }
 }
 
+void FullRingInfinity::BuildParameterisedSensors()
+{
+  // Same positions, rotations and numbering of sensors as in BuildSensors(),
+  // but with a single physical volume, which Geant4 requires to be
+  // the only daughter of its mother
+  if (charge_det_)
+    G4Exception("[FullRingInfinity]", "BuildParameterisedSensors()",
+                FatalErrorInArgument,
+                "Parameterised sensors cannot be used with the charge detector.");
+
+  sipm_param_ = new SiPMRingParameterisation();
+
+  G4RotationMatrix rot;
+  rot.rotateX(-pi / 2.);
+
+  G4int n_sipm_int = 2 * pi * inner_radius_ / sipm_pitch_;
+  if (instr_faces_ == 2) {
+    G4cout << "Number of sipms in inner face: " << n_sipm_int * n_sipm_rows_
+           << G4endl;
+    sipm_param_->AddFace(n_sipm_int, n_sipm_rows_,
+                         inner_radius_ + sipm_dim_.z() / 2., sipm_pitch_, rot);
+  }
+
+  n_sipm_ext_ = 2 * pi * external_radius_ / sipm_pitch_;
+  G4cout << "Number of sipms in external face: " << n_sipm_ext_ * n_sipm_rows_
+         << G4endl;
+  rot.rotateX(pi);
+  sipm_param_->AddFace(n_sipm_ext_, n_sipm_rows_,
+                       inner_radius_ + lxe_depth_ + sipm_dim_.z() / 2.,
+                       sipm_pitch_, rot);
+
+  new G4PVParameterised("SIPM", sipm_->GetLogicalVolume(), active_logic_,
+                        kUndefined, sipm_param_->GetNumberOfSensors(),
+                        sipm_param_);
+}
+
+void FullRingInfinity::BuildRayTracer()
+{
+  // Same volumes and numbering of sensors as in BuildCryostat()
+  // and BuildSensors(), described analytically
+  G4double r_in = inner_radius_;
+  if (instr_faces_ == 2)
+    r_in += sipm_dim_.z();
+  G4double r_out = inner_radius_ + lxe_depth_;
+
+  tracer_ = new RingRayTracer();
+  tracer_->SetRing(r_in, r_out, axial_length_);
+
+  G4double pd_z = sipm_->GetPhotodiodeZ();
+  G4int first_id = 1000;
+  if (instr_faces_ == 2) {
+    G4int n_sipm_int = 2 * pi * inner_radius_ / sipm_pitch_;
+    tracer_->SetSensorFace(0, n_sipm_int, n_sipm_rows_, sipm_pitch_, first_id,
+                           inner_radius_ + sipm_dim_.z()/2. + pd_z);
+    first_id += n_sipm_int * n_sipm_rows_;
+  }
+  tracer_->SetSensorFace(1, n_sipm_ext_, n_sipm_rows_, sipm_pitch_, first_id,
+                         r_out + sipm_dim_.z()/2. - pd_z);
+
+  tracer_->SetSensors(sipm_dim_.x(), sipm_->GetWindowRefractiveIndex(),
+                      sipm_->GetWindowThickness(), sipm_->GetEfficiency());
+  tracer_->SetWallReflectivity(wall_refl_);
+  tracer_->SetMaterialProperties(LXe_->GetMaterialPropertiesTable());
+}
+
 void FullRingInfinity::BuildWires()
 {
   // Add simple detector for charge
@@ -498,12 +647,19 @@ void FullRingInfinity::BuildWires()
   G4LogicalVolume* chdet_logic =
     new G4LogicalVolume(chdet_solid, LXe_, "WIRE");
 
+  G4double chdet_radius =
+    inner_radius_ + lxe_depth_ - chdet_thickn_ / 2. - chdet_offset_;
+  G4int n_wires = 2. * pi * chdet_radius / wire_pitch_;
+  G4cout << "Number of wires: " << n_wires << G4endl;
+
   G4String sdname = "/WIRE/ChargeDet";
   G4SDManager* sdmgr = G4SDManager::GetSDMpointer();
   if (!sdmgr->FindSensitiveDetector(sdname, false))
     {
       ChargeSD* chargesd = new ChargeSD(sdname);
       chargesd->SetTimeBinning(wire_time_bin_);
+      // Needed by the parametric drift of electrons
+      chargesd->SetWireRing(chdet_radius, n_wires);
       G4SDManager::GetSDMpointer()->AddNewDetector(chargesd);
       chdet_logic->SetSensitiveDetector(chargesd);
     }
@@ -512,11 +668,6 @@ void FullRingInfinity::BuildWires()
   wire_col.SetForceSolid(true);
   chdet_logic->SetVisAttributes(wire_col);
 
-  G4double chdet_radius =
-    inner_radius_ + lxe_depth_ - chdet_thickn_ / 2. - chdet_offset_;
-  G4int n_wires = 2. * pi * chdet_radius / wire_pitch_;
-  G4cout << "Number of wires: " << n_wires << G4endl;
-
   G4ThreeVector chdet_position(0., chdet_radius, 0.);
   G4int chdet_copy_no = 0;
   G4String chdet_vol_name = "WIRE_" + std::to_string(chdet_copy_no);
@@ -604,6 +755,14 @@ void FullRingInfinity::BuildSeparators()
 }
 
 
+void FullRingInfinity::BuildVoxelizedPhantom()
+{
+  vox_phantom_geom_->Construct();
+  G4LogicalVolume* phantom_logic = vox_phantom_geom_->GetLogicalVolume();
+  new G4PVPlacement(0, G4ThreeVector(0, 0, 0), phantom_logic, "VPHANTOM",
+                    lab_logic_, false, 0, true);
+}
+
 void FullRingInfinity::BuildPhantom()
 {
   jas_phantom_ = new JaszczakPhantom();
@@ -640,31 +799,50 @@ G4ThreeVector FullRingInfinity::GenerateVertex(const G4String &region) const
   {
     vertex = jas_phantom_->GenerateVertex("JPHANTOM");
   }
+  else if (region == "VPHANTOM")
+  {
+    vertex = vox_phantom_geom_->GenerateVertex("VPHANTOM");
+  }
   else if (region == "CUSTOM")
   {
     vertex = RandomPointVertex();
   }
   else if (region == "SENSITIVITY")
   {
-    unsigned int i = sensitivity_point_id_ + sensitivity_index_;
-
-    if (i == (sensitivity_vertices_.size() * events_per_point_ - 1))
+    // Each point of the slice of this job is used for events_per_point_
+    // consecutive events. The run is aborted only once all of them
+    // have been generated. An event beyond the slice has no point
+    // (GetSensitivityPoint() returns -1), and the generator must abort it,
+    // since the run abort only takes effect after the current event.
+    unsigned int i =
+      sensitivity_point_id_ * events_per_point_ + sensitivity_index_;
+
+    if (i >= (unsigned int)((sens_last_ - sens_first_) * events_per_point_))
     {
+      sensitivity_current_point_ = -1;
       G4Exception("[FullRingInfinity]", "GenerateVertex()",
-                  RunMustBeAborted, "Reached last event in sensitivity map.");
+                  RunMustBeAborted,
+                  "All the events of the sensitivity points of this job have been generated.");
+      return vertex;
     }
 
-    try
-    {
-      auto pos = i % sensitivity_vertices_.size();
-      vertex = sensitivity_vertices_.at(pos);
-      sensitivity_index_++;
-    }
-    catch (const std::out_of_range &oor)
+    sensitivity_current_point_ = sens_first_ + i / events_per_point_;
+    vertex = sensitivity_vertices_[sensitivity_current_point_];
+    sensitivity_index_++;
+  }
+  else if (region == "LUT")
+  {
+    // Each voxel centre is used for events_per_point_ consecutive events.
+    // Extra events start again from the first voxel, so that they only add
+    // statistics to points already in the table.
+    if (lut_vertices_.empty())
     {
-      G4Exception("[FullRingInfinity]", "GenerateVertex()",
-                  FatalErrorInArgument, "Sensitivity point out of range.");
+      G4Exception("[FullRingInfinity]", "GenerateVertex()", FatalException,
+                  "No LUT points: set /Geometry/FullRingInfinity/lut true.");
     }
+    unsigned int i = lut_index_ / events_per_point_;
+    vertex = lut_vertices_[i % lut_vertices_.size()];
+    lut_index_++;
   }
   else
   {
@@ -674,67 +852,60 @@ G4ThreeVector FullRingInfinity::GenerateVertex(const G4String &region) const
   return vertex;
 }
 
-G4int FullRingInfinity::binarySearchPt(G4int low,
-                                       G4int high, G4double rnd) const
-{
-
-  // Error
-  if (high < 0 || low >= pt_Nx_ * pt_Ny_ * pt_Nz_)
-    return -1;
-
-  // Return the element before the first element greater than rnd.
-  if (pt_[low] > rnd)
-    return low - 1;
-
-  G4int mid = (low + high) / 2;
-  if (pt_[mid] <= rnd)
-    return binarySearchPt(mid + 1, high, rnd);
-  return binarySearchPt(low, mid - 1, rnd);
-}
-
 // Generates a vertex corresponding to a random point from the custom volume.
 G4ThreeVector FullRingInfinity::RandomPointVertex() const
 {
-  // Select the index in the cumulative distribution.
-  G4double rnd = G4UniformRand();
-  G4int ipt = binarySearchPt(0, pt_Nx_ * pt_Ny_ * pt_Nz_ - 1, rnd);
-
-  if (ipt < 0)
+  if (!pt_sampler_)
   {
-    std::cerr << "ERROR: random point vertex selection failed." << std::endl;
-    return G4ThreeVector(0, 0, 0);
+    G4Exception("[FullRingInfinity]", "RandomPointVertex()", FatalException,
+                "No point file: set /Geometry/FullRingInfinity/pointFile.");
   }
-  //G4int jpt = 0;
-  //while(pt_[jpt] < rnd) jpt++;
-  //jpt -= 1;
-  //if(ipt != jpt) std::cout << "WARNING: algorithms don't match i = " << ipt
-  // << ", j = " << jpt << "***" << std::endl;
-
-  // Compute the vertex.
-  G4int nx = ipt / (pt_Ny_ * pt_Nz_);
-  G4int ny = (ipt / pt_Nz_) % pt_Ny_;
-  G4int nz = ipt % pt_Nz_;
-  G4double x = pt_Lx_ * (((G4double)nx) / pt_Nx_ - 0.5);
-  G4double y = pt_Ly_ * (((G4double)ny) / pt_Ny_ - 0.5);
-  G4double z = pt_Lz_ * (((G4double)nz) / pt_Nz_ - 0.5);
-
-  G4double xrnd = G4UniformRand() - 0.5;
-  G4double yrnd = G4UniformRand() - 0.5;
-  G4double zrnd = G4UniformRand() - 0.5;
-
-  //std::cout << "Generated at point (" << x << ", " << y << ", " << z << "),
-  // index " << ipt << std::endl;
-  return G4ThreeVector(x + xrnd, y + yrnd, z + zrnd);
+
+  return pt_sampler_->GenerateVertex();
 }
 
 void FullRingInfinity::BuildPointfile(G4String pointFile)
 {
+  delete pt_sampler_;
+  pt_sampler_ = 0;
+  delete pt_file_;
+  pt_file_ = 0;
+
+  // Files in format v2 are mapped in memory and used directly.
+  if (ActivityMapFile::IsVersion2(pointFile))
+  {
+    pt_file_ = new ActivityMapFile(pointFile);
+    pt_sampler_ =
+      new VoxelPointSampler(pt_file_->GetNx(), pt_file_->GetNy(),
+                            pt_file_->GetNz(), pt_file_->GetLx(),
+                            pt_file_->GetLy(), pt_file_->GetLz());
+    pt_sampler_->SetTables(pt_file_->GetNumberOfEntries(),
+                           pt_file_->GetVoxels(),
+                           pt_file_->GetProbabilities(),
+                           pt_file_->GetAliases());
+
+    G4cout << "Mapped distribution of (" << pt_file_->GetNx() << ", "
+           << pt_file_->GetNy() << ", " << pt_file_->GetNz() << "); Len ("
+           << pt_file_->GetLx() << ", " << pt_file_->GetLy() << ", "
+           << pt_file_->GetLz() << "); with "
+           << pt_file_->GetNumberOfEntries() << " voxels with activity."
+           << G4endl;
+    return;
+  }
+
+  // Legacy format: header followed by the cumulative distribution
+  // of all the voxels.
   int Nx, Ny, Nz;
   float Lx, Ly, Lz;
 
   // Open the file containing the point distribution.
   std::ifstream is;
   is.open(pointFile, std::ifstream::binary);
+  if (!is.good())
+  {
+    G4Exception("[FullRingInfinity]", "BuildPointfile()", FatalException,
+                ("Cannot open point file " + pointFile).c_str());
+  }
 
   // Read the header.
   is.read(reinterpret_cast<char *>(&Nx), sizeof(int));
@@ -743,30 +914,27 @@ void FullRingInfinity::BuildPointfile(G4String pointFile)
   is.read(reinterpret_cast<char *>(&Lx), sizeof(float));
   is.read(reinterpret_cast<char *>(&Ly), sizeof(float));
   is.read(reinterpret_cast<char *>(&Lz), sizeof(float));
-  pt_Nx_ = Nx;
-  pt_Ny_ = Ny;
-  pt_Nz_ = Nz;
-  pt_Lx_ = Lx;
-  pt_Ly_ = Ly;
-  pt_Lz_ = Lz;
-
-  // Read the distribution.
-  int i = 0;
-  float f;
-  int length = pt_Nx_ * pt_Ny_ * pt_Nz_;
-  pt_ = new G4float[length];
-  while (is.read(reinterpret_cast<char *>(&f), sizeof(float)))
+
+  // Read the cumulative distribution, stored in single precision.
+  // The probabilities of the voxels are computed in double precision.
+  G4int length = Nx * Ny * Nz;
+  std::vector<G4float> buffer(length, 1.);
+  is.read(reinterpret_cast<char *>(buffer.data()), length * sizeof(float));
+  if (is.gcount() != (std::streamsize)(length * sizeof(float)))
   {
-    pt_[i] = f;
-    i++;
+    G4Exception("[FullRingInfinity]", "BuildPointfile()", FatalException,
+                "Point file shorter than the size given in its header.");
   }
-
   is.close();
 
-  std::cout << "Read distribution of (" << pt_Nx_ << ", " << pt_Ny_ << ", "
-            << pt_Nz_ << "); Len (" << pt_Lx_ << ", " << pt_Ly_ << ", "
-            << pt_Lz_ << "); with total elements = " << length
-            << ", and first two = " << pt_[0] << " , " << pt_[1] << std::endl;
+  pt_sampler_ = new VoxelPointSampler(Nx, Ny, Nz, Lx, Ly, Lz);
+  pt_sampler_->SetCumulativeActivity(buffer);
+
+  G4cout << "Read distribution of (" << Nx << ", " << Ny << ", "
+         << Nz << "); Len (" << Lx << ", " << Ly << ", "
+         << Lz << "); with total elements = " << length
+         << ", of which " << pt_sampler_->GetNumberOfActiveVoxels()
+         << " with activity." << G4endl;
 }
 
 void FullRingInfinity::CalculateSensitivityVertices(G4double binning)
@@ -796,4 +964,63 @@ void FullRingInfinity::CalculateSensitivityVertices(G4double binning)
   }
   G4cout << "Number of points in sensitivity map = "
          << sensitivity_vertices_.size() << G4endl;
+
+  // Slice of points of this job. The slices of all the jobs cover
+  // the whole map without overlapping.
+  if (job_id_ >= num_jobs_)
+  {
+    G4Exception("[FullRingInfinity]", "CalculateSensitivityVertices()",
+                FatalErrorInArgument, "job_id must be smaller than num_jobs.");
+  }
+  G4long n_points = sensitivity_vertices_.size();
+  sens_first_ = n_points * job_id_ / num_jobs_;
+  sens_last_  = n_points * (job_id_ + 1) / num_jobs_;
+
+  G4cout << "Sensitivity points of job " << job_id_ << " of " << num_jobs_
+         << ": [" << sens_first_ << ", " << sens_last_ << "), "
+         << (sens_last_ - sens_first_) * events_per_point_
+         << " events needed." << G4endl;
+
+  // Information needed to merge the output of all the jobs
+  PetaloPersistencyManager* pm = dynamic_cast<PetaloPersistencyManager*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm)
+  {
+    pm->AddRunInfo("sensitivity_num_points", std::to_string(n_points));
+    pm->AddRunInfo("sensitivity_first_point", std::to_string(sens_first_));
+    pm->AddRunInfo("sensitivity_last_point", std::to_string(sens_last_));
+    pm->AddRunInfo("sensitivity_job_id", std::to_string(job_id_));
+    pm->AddRunInfo("sensitivity_num_jobs", std::to_string(num_jobs_));
+  }
+}
+
+void FullRingInfinity::CalculateLUTVertices(G4double binning)
+{
+  // Centres of the voxels of a cartesian grid that fall inside the LXe
+  // between the two instrumented faces.
+  lut_vertices_.clear();
+
+  G4int n_xy = floor(2. * external_radius_ / binning);
+  G4int n_z  = floor(axial_length_ / binning);
+
+  for (G4int i = 0; i < n_xy; i++)
+  {
+    G4double x = -external_radius_ + (i + 0.5) * binning;
+    for (G4int j = 0; j < n_xy; j++)
+    {
+      G4double y = -external_radius_ + (j + 0.5) * binning;
+      G4double r2 = x * x + y * y;
+      if (r2 < inner_radius_ * inner_radius_ ||
+          r2 >= external_radius_ * external_radius_)
+        continue;
+      for (G4int k = 0; k < n_z; k++)
+      {
+        G4double z = -axial_length_/2. + (k + 0.5) * binning;
+        lut_vertices_.push_back(G4ThreeVector(x, y, z));
+      }
+    }
+  }
+  G4cout << "Number of points in light-response table = "
+         << lut_vertices_.size() << "; events needed = "
+         << lut_vertices_.size() * events_per_point_ << G4endl;
 }
@@ -19,6 +19,11 @@ class G4Material;
 
 class SiPMpetVUV;
 class JaszczakPhantom;
+class VoxelizedPhantom;
+class RingRayTracer;
+class SiPMRingParameterisation;
+class VoxelPointSampler;
+class ActivityMapFile;
 
 namespace nexus
 {
@@ -39,18 +44,28 @@ public:
   /// Generate a vertex within a given region of the geometry
   G4ThreeVector GenerateVertex(const G4String &region) const;
 
+  /// Analytic optical transport for the LXe between the sensor faces
+  RingRayTracer* GetRayTracer() const;
+
+  /// Index, within the whole sensitivity map, of the point used for
+  /// the last vertex generated in the SENSITIVITY region (-1 if none)
+  G4int GetSensitivityPoint() const;
+
 private:
   void Construct();
   void BuildCryostat();
   void BuildQuadSensors();
   void BuildSensors();
+  void BuildParameterisedSensors();
+  void BuildRayTracer();
   void BuildWires();
   void BuildSeparators();
   void BuildPhantom();
+  void BuildVoxelizedPhantom();
   void BuildPointfile(G4String pointFile);
-  G4int binarySearchPt(G4int low, G4int high, G4double rnd) const;
   G4ThreeVector RandomPointVertex() const;
   void CalculateSensitivityVertices(G4double binning);
+  void CalculateLUTVertices(G4double binning);
 
   SiPMpetVUV *sipm_;
 
@@ -67,6 +82,11 @@ private:
   G4int instr_faces_; ///< number of instrumented faces
   G4bool charge_det_;
   G4bool separators_;
+  G4bool param_sensors_; ///< true if SiPMs are a single parameterised volume
+
+  G4double smartless_lxe_;    ///< smartless of the smart voxels of LXE
+  G4double smartless_active_; ///< smartless of the smart voxels of ACTIVE
+  G4bool optimise_;           ///< true if LXE and ACTIVE have smart voxels
   G4double wire_pitch_;
   G4double wire_time_bin_;
   G4double chdet_thickn_;
@@ -97,24 +117,45 @@ private:
   G4ThreeVector specific_vertex_;
 
   G4bool phantom_;
+  G4bool vox_phantom_; ///< true if a phantom from medical images is used
 
-  // Variables for the point generator.
-  G4int pt_Nx_, pt_Ny_, pt_Nz_;
-  G4float pt_Lx_, pt_Ly_, pt_Lz_;
-  G4float *pt_;
+  VoxelPointSampler* pt_sampler_; ///< Generator of the CUSTOM points
+  ActivityMapFile* pt_file_;      ///< Mapped point file (format v2)
 
   G4bool sensitivity_;
   G4int events_per_point_;
   G4int sensitivity_point_id_;
   mutable G4int sensitivity_index_;
+  mutable G4int sensitivity_current_point_; ///< point of the last vertex
   mutable std::vector<G4ThreeVector> sensitivity_vertices_;
+  G4int job_id_;     ///< index of this job in a partitioned sensitivity run
+  G4int num_jobs_;   ///< number of jobs in a partitioned sensitivity run
+  G4int sens_first_; ///< first sensitivity point of this job
+  G4int sens_last_;  ///< one past the last sensitivity point of this job
   G4double sensitivity_binning_;
   G4double sens_x_min_, sens_x_max_;
   G4double sens_y_min_, sens_y_max_;
   G4double sens_z_min_, sens_z_max_;
 
+  G4bool lut_; ///< true if a light-response table is being generated
+  G4double lut_binning_;
+  mutable G4int lut_index_;
+  std::vector<G4ThreeVector> lut_vertices_;
+
   G4Material* LXe_;
   JaszczakPhantom* jas_phantom_;
+  VoxelizedPhantom* vox_phantom_geom_;
+
+  RingRayTracer* tracer_;
+  SiPMRingParameterisation* sipm_param_; ///< owned, used by the SIPM volume
 };
 
+inline G4int FullRingInfinity::GetSensitivityPoint() const
+{ return sensitivity_current_point_; }
+
+inline RingRayTracer* FullRingInfinity::GetRayTracer() const
+{
+  return tracer_;
+}
+
 #endif
@@ -49,7 +49,11 @@ FullRingTiles::FullRingTiles() : GeometryBase(),
                                  inner_radius_(165 * cm),
                                  cryo_width_(12. * cm),
                                  cryo_thickn_(1. * mm),
-                                 max_step_size_(1. * mm)
+                                 max_step_size_(1. * mm),
+                                 smartless_lxe_(2.),
+                                 smartless_active_(2.),
+                                 smartless_tile_(2.),
+                                 optimise_(true)
 {
   // Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/FullRingTiles/",
@@ -71,6 +75,14 @@ FullRingTiles::FullRingTiles() : GeometryBase(),
   msg_->DeclareProperty("tile_rows", n_tile_rows_, "Number of tile rows");
   msg_->DeclareProperty("instrumented_faces", instr_faces_,
                         "Number of instrumented faces");
+  msg_->DeclareProperty("smartless_lxe", smartless_lxe_,
+                        "Smartless of the navigation voxels of the LXe volume");
+  msg_->DeclareProperty("smartless_active", smartless_active_,
+                        "Smartless of the navigation voxels of the active volume");
+  msg_->DeclareProperty("smartless_tile", smartless_tile_,
+                        "Smartless of the navigation voxels of the tiles");
+  msg_->DeclareProperty("optimisation", optimise_,
+                        "True if the LXe, active and tile volumes are voxelised for navigation");
 
   tile_ = new Tile();
 
@@ -110,6 +122,14 @@ void FullRingTiles::Construct()
          << ", " << external_radius_ / mm << G4endl;
   BuildCryostat();
   BuildSensors();
+
+  // Navigation settings of the volumes with many daughters
+  LXe_logic_->SetSmartless(smartless_lxe_);
+  LXe_logic_->SetOptimisation(optimise_);
+  active_logic_->SetSmartless(smartless_active_);
+  active_logic_->SetOptimisation(optimise_);
+  tile_logic_->SetSmartless(smartless_tile_);
+  tile_logic_->SetOptimisation(optimise_);
 }
 
 void FullRingTiles::BuildCryostat()
@@ -135,7 +155,9 @@ void FullRingTiles::BuildCryostat()
                  external_radius_ + ext_offset + kapton_thickn_,
                  (lat_dimension_cell_ + 2. * kapton_thickn_) / 2., 0, twopi);
   G4Material* LXe = G4NistManager::Instance()->FindOrBuildMaterial("G4_lXe");
-  LXe->SetMaterialPropertiesTable(opticalprops::LXe());
+  LXe->SetMaterialPropertiesTable(
+    petopticalprops::Memoize("nexus::LXe", {},
+                             [] { return opticalprops::LXe(); }));
   LXe_logic_ =
       new G4LogicalVolume(LXe_solid, LXe, "LXE");
   new G4PVPlacement(0, G4ThreeVector(0., 0., 0.), LXe_logic_,
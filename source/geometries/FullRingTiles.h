@@ -69,6 +69,11 @@ private:
   G4LogicalVolume *tile_logic_;
   G4ThreeVector tile_dim_;
 
+  G4double smartless_lxe_;    ///< smartless of the smart voxels of LXE
+  G4double smartless_active_; ///< smartless of the smart voxels of ACTIVE
+  G4double smartless_tile_;   ///< smartless of the smart voxels of the tiles
+  G4bool optimise_; ///< true if LXE, ACTIVE and the tiles have smart voxels
+
   CylinderPointSamplerLegacy *cylindric_gen_;
 };
 
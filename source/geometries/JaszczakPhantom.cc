@@ -2,6 +2,9 @@
 // petalosim | JaszczakPhantom.cc
 //
 // This class implements the geometry of a Jaszczak phantom, filled with water.
+// Vertices are generated analytically: a compartment (background, sphere
+// or rod) is chosen with probability proportional to activity times volume,
+// and the point is then drawn uniformly inside it.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
@@ -10,7 +13,6 @@
 
 #include "nexus/FactoryBase.h"
 #include "nexus/Visibilities.h"
-#include "nexus/CylinderPointSampler.h"
 
 #include <G4Tubs.hh>
 #include <G4Orb.hh>
@@ -21,8 +23,7 @@
 #include <G4RotationMatrix.hh>
 #include <G4VisAttributes.hh>
 #include <G4GenericMessenger.hh>
-#include <G4TransportationManager.hh>
-#include <G4Navigator.hh>
+#include <Randomize.hh>
 
 using namespace nexus;
 
@@ -56,15 +57,12 @@ JaszczakPhantom::JaszczakPhantom(): GeometryBase(),
   msg_->DeclareProperty("bckg_activity",   bckg_activity_,   "Activity of the background of the phantom");
   msg_->DeclareProperty("sphere_activity", sphere_activity_, "Activity of the spheres");
   msg_->DeclareProperty("rod_activity",    rod_activity_,    "Activity of the rods");
-
-  /// Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 }
 
 
 JaszczakPhantom::~JaszczakPhantom()
 {
+  delete msg_;
 }
 
 
@@ -90,11 +88,13 @@ void JaszczakPhantom::Construct()
   G4Material* water = G4NistManager::Instance()->FindOrBuildMaterial("G4_WATER");
   auto water_logic =
     new G4LogicalVolume(water_solid, water, water_name);
-  G4VPhysicalVolume* water_phys =
-    new G4PVPlacement(0, G4ThreeVector(0., 0., 0.), water_logic, water_name, cylinder_logic,
-                      false, 0, true);
+  new G4PVPlacement(0, G4ThreeVector(0., 0., 0.), water_logic, water_name, cylinder_logic,
+                    false, 0, true);
 
-  cyl_gen_ = new CylinderPointSampler(water_phys);
+  // Background compartment
+  compartments_.clear();
+  compartments_.push_back({G4ThreeVector(0., 0., 0.),
+                           cylinder_inner_diam_/2, cylinder_height_/2.});
 
   // Spheres
   std::vector<G4double> sphere_radii =
@@ -123,11 +123,12 @@ void JaszczakPhantom::Construct()
   G4cout << "*** Relative activities (background, spheres, rods) ***" << G4endl;
   G4cout << bckg_activity_ << ", " << sphere_activity_  << ", " << rod_activity_ << G4endl;
 
+  BuildActivitySampler();
 }
 
 
 void JaszczakPhantom::BuildSpheres(unsigned long n, G4double r, G4double r_pos, G4double z_pos,
-                                   G4LogicalVolume* mother_logic, G4Material* mat) const
+                                   G4LogicalVolume* mother_logic, G4Material* mat)
 {
   auto sphere_name = "SPHERE" + std::to_string(n);
   auto sphere_solid = new G4Orb(sphere_name, r);
@@ -137,12 +138,14 @@ void JaszczakPhantom::BuildSpheres(unsigned long n, G4double r, G4double r_pos,
   auto y_pos = r_pos * sin(angle);
   new G4PVPlacement(0, G4ThreeVector(x_pos, y_pos, z_pos), sphere_logic,
                     sphere_name, mother_logic, false, 0, false);
+
+  compartments_.push_back({G4ThreeVector(x_pos, y_pos, z_pos), r, 0.});
 }
 
 
 
 void JaszczakPhantom::BuildRods(unsigned long n, G4double r, G4double z_pos,
-                                G4LogicalVolume* mother_logic, G4Material* mat) const
+                                G4LogicalVolume* mother_logic, G4Material* mat)
   {
     auto diam = 2 * r;
 
@@ -172,6 +175,7 @@ void JaszczakPhantom::BuildRods(unsigned long n, G4double r, G4double z_pos,
         G4ThreeVector pos = G4ThreeVector(x_pos, y_pos, z_pos);
         G4ThreeVector newpos = pos.rotateZ(n*pi/3);
         new G4PVPlacement(0, newpos, rod_logic, label, mother_logic, false, 0, false);
+        compartments_.push_back({newpos, r, rod_height_/2});
 
         G4VisAttributes col = nexus::Blue();
         col.SetForceSolid(true);
@@ -181,23 +185,71 @@ void JaszczakPhantom::BuildRods(unsigned long n, G4double r, G4double z_pos,
   }
 
 
-G4ThreeVector JaszczakPhantom::GenerateVertex(const G4String &/*region*/) const
+void JaszczakPhantom::BuildActivitySampler()
 {
-  G4ThreeVector vertex(0, 0, 0);
-  G4VPhysicalVolume* VertexVolume;
+  // Weight of each compartment: activity times volume. The spheres and
+  // rods are removed from the volume of the background.
+  std::vector<G4double> weights(compartments_.size(), 0.);
+  G4double bckg_volume = pi * std::pow(compartments_[0].radius, 2) *
+    2 * compartments_[0].half_height;
+
+  for (unsigned long i=1; i<compartments_.size(); i++) {
+    const Compartment& c = compartments_[i];
+    G4double volume;
+    if (c.half_height > 0.) {
+      volume = pi * c.radius * c.radius * 2 * c.half_height;
+      weights[i] = rod_activity_ * volume;
+    } else {
+      volume = 4./3. * pi * std::pow(c.radius, 3);
+      weights[i] = sphere_activity_ * volume;
+    }
+    bckg_volume -= volume;
+  }
+  weights[0] = bckg_activity_ * bckg_volume;
 
-  while (true) {
-    vertex = cyl_gen_->GenerateVertex(VOLUME);
-    VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(vertex, 0, false);
-    G4String vol_name = VertexVolume->GetName();
-
-    if (G4StrUtil::starts_with(vol_name, "WATER_BCKG")) {
-      if (((float)std::rand() / (float)RAND_MAX) < bckg_activity_) return vertex;
-    } else if (G4StrUtil::starts_with(vol_name, "SPHERE")) {
-      if (((float)std::rand() / (float)RAND_MAX) < sphere_activity_) return vertex;
-    } else if (G4StrUtil::starts_with(vol_name, "ROD")) {
-      if (((float)std::rand() / (float)RAND_MAX) < rod_activity_) return vertex;
+  compartment_sampler_.SetWeights(weights);
+}
+
+
+G4bool JaszczakPhantom::InsideHotCompartment(const G4ThreeVector& point) const
+{
+  for (unsigned long i=1; i<compartments_.size(); i++) {
+    const Compartment& c = compartments_[i];
+    G4ThreeVector d = point - c.centre;
+    if (c.half_height > 0.) {
+      if (std::abs(d.z()) < c.half_height && d.perp2() < c.radius * c.radius)
+        return true;
+    } else if (d.mag2() < c.radius * c.radius) {
+      return true;
     }
   }
+  return false;
+}
+
 
+G4ThreeVector JaszczakPhantom::GenerateVertex(const G4String &/*region*/) const
+{
+  unsigned long i = compartment_sampler_.Sample();
+  const Compartment& c = compartments_[i];
+
+  if (c.half_height == 0.) {
+    // Uniform point inside a sphere
+    G4double r         = c.radius * std::cbrt(G4UniformRand());
+    G4double cos_theta = 2. * G4UniformRand() - 1.;
+    G4double sin_theta = std::sqrt(1. - cos_theta * cos_theta);
+    G4double phi       = twopi * G4UniformRand();
+    return c.centre + r * G4ThreeVector(sin_theta * std::cos(phi),
+                                        sin_theta * std::sin(phi), cos_theta);
+  }
+
+  // Uniform point inside a cylinder. For the background, points falling
+  // inside a sphere or a rod are drawn again.
+  while (true) {
+    G4double r   = c.radius * std::sqrt(G4UniformRand());
+    G4double phi = twopi * G4UniformRand();
+    G4double z   = c.half_height * (2. * G4UniformRand() - 1.);
+    G4ThreeVector vertex =
+      c.centre + G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z);
+    if (i > 0 || !InsideHotCompartment(vertex)) return vertex;
+  }
 }
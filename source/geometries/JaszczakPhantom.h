@@ -2,6 +2,9 @@
 // petalosim | JaszczakPhantom.h
 //
 // This class implements the geometry of a Jaszczak phantom, filled with water.
+// Vertices are generated analytically: a compartment (background, sphere
+// or rod) is chosen with probability proportional to activity times volume,
+// and the point is then drawn uniformly inside it.
 //
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
@@ -9,17 +12,14 @@
 #ifndef JASZCZAK_PHANTOM_H
 #define JASZCZAK_PHANTOM_H
 
+#include "AliasSampler.h"
+
 #include "nexus/GeometryBase.h"
 
+#include <vector>
+
 class G4Material;
 class G4GenericMessenger;
-class G4Navigator;
-
-namespace nexus
-{
-  class SpherePointSampler;
-  class CylinderPointSampler;
-}
 
 using namespace nexus;
 
@@ -37,14 +37,26 @@ class JaszczakPhantom: public GeometryBase
  private:
 
   void BuildSpheres(unsigned long n, G4double r, G4double r_pos, G4double z_pos,
-                 G4LogicalVolume* mother_logic, G4Material* mat) const;
+                 G4LogicalVolume* mother_logic, G4Material* mat);
   void BuildRods(unsigned long n, G4double r, G4double z_pos,
-                 G4LogicalVolume* mother_logic, G4Material* mat) const;
+                 G4LogicalVolume* mother_logic, G4Material* mat);
+
+  /// Build the table used to choose the compartment of each vertex
+  void BuildActivitySampler();
+  /// Return true if the point is inside a sphere or a rod
+  G4bool InsideHotCompartment(const G4ThreeVector& point) const;
 
   G4GenericMessenger *msg_;
-  G4Navigator* geom_navigator_;
 
-  CylinderPointSampler* cyl_gen_;
+  /// Compartments of the phantom. Index 0 is the background,
+  /// then come the spheres and then the rods.
+  struct Compartment {
+    G4ThreeVector centre;
+    G4double radius;
+    G4double half_height; ///< zero for spheres
+  };
+  std::vector<Compartment> compartments_;
+  AliasSampler compartment_sampler_;
 
   G4double bckg_activity_;
   G4double sphere_activity_;
@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------------
+// petalosim | SiPMRingParameterisation.cc
+//
+// Parameterisation of the SiPMs of the faces of a ring, so that all of them
+// are described by a single G4PVParameterised instead of one G4PVPlacement
+// each. SiPMs are numbered face by face, row by row (along z) and, within a
+// row, by their azimuthal index, as in FullRingInfinity::BuildSensors().
+// All the SiPMs with the same azimuthal index of a face share the same
+// rotation matrix.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SiPMRingParameterisation.h"
+
+#include <G4VPhysicalVolume.hh>
+#include <G4PhysicalConstants.hh>
+
+SiPMRingParameterisation::SiPMRingParameterisation():
+  G4VPVParameterisation(), n_sensors_(0)
+{
+}
+
+
+
+SiPMRingParameterisation::~SiPMRingParameterisation()
+{
+  for (auto& face: faces_)
+    for (auto r: face.rot) delete r;
+}
+
+
+
+void SiPMRingParameterisation::AddFace(G4int n_phi, G4int n_rows,
+                                       G4double radius, G4double pitch,
+                                       const G4RotationMatrix& rot)
+{
+  Face face;
+  face.first  = n_sensors_;
+  face.n_phi  = n_phi;
+  face.n_rows = n_rows;
+  face.radius = radius;
+  face.pitch  = pitch;
+
+  // Physical volumes hold the inverse of the rotation of the
+  // solid, as G4PVPlacement does when built from a G4Transform3D
+  G4double step = twopi / n_phi;
+  face.rot.reserve(n_phi);
+  for (G4int i=0; i<n_phi; i++) {
+    G4RotationMatrix r = rot;
+    r.rotateZ(i * step);
+    face.rot.push_back(new G4RotationMatrix(r.inverse()));
+  }
+
+  faces_.push_back(face);
+  n_sensors_ += n_phi * n_rows;
+}
+
+
+
+void SiPMRingParameterisation::ComputeTransformation(const G4int copy_no,
+                                                     G4VPhysicalVolume* phys) const
+{
+  const Face* face = &faces_.front();
+  for (auto& f: faces_)
+    if (copy_no >= f.first) face = &f;
+
+  G4int index = copy_no - face->first;
+  G4int row = index / face->n_phi;
+  G4int i   = index % face->n_phi;
+
+  G4double angle = i * twopi / face->n_phi;
+  G4double z = (row + 0.5 - face->n_rows / 2.) * face->pitch;
+
+  phys->SetTranslation(G4ThreeVector(-face->radius * std::sin(angle),
+                                      face->radius * std::cos(angle), z));
+  phys->SetRotation(face->rot[i]);
+}
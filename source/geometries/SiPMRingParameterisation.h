@@ -0,0 +1,59 @@
+// ----------------------------------------------------------------------------
+// petalosim | SiPMRingParameterisation.h
+//
+// Parameterisation of the SiPMs of the faces of a ring, so that all of them
+// are described by a single G4PVParameterised instead of one G4PVPlacement
+// each. SiPMs are numbered face by face, row by row (along z) and, within a
+// row, by their azimuthal index, as in FullRingInfinity::BuildSensors().
+// All the SiPMs with the same azimuthal index of a face share the same
+// rotation matrix.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SIPM_RING_PARAMETERISATION_H
+#define SIPM_RING_PARAMETERISATION_H
+
+#include <G4VPVParameterisation.hh>
+#include <G4RotationMatrix.hh>
+#include <vector>
+
+class SiPMRingParameterisation : public G4VPVParameterisation
+{
+public:
+  /// Constructor
+  SiPMRingParameterisation();
+  /// Destructor
+  ~SiPMRingParameterisation();
+
+  /// Add a face of n_phi x n_rows SiPMs centred at the given radius.
+  /// Rows have a given pitch along z and are centred at z = 0. The SiPM
+  /// with azimuthal index i is rotated by rot_z(i * 2pi / n_phi) * rot,
+  /// where rot is the rotation of the SiPM with i = 0.
+  void AddFace(G4int n_phi, G4int n_rows, G4double radius, G4double pitch,
+               const G4RotationMatrix& rot);
+
+  /// Total number of SiPMs of all the faces
+  G4int GetNumberOfSensors() const;
+
+  void ComputeTransformation(const G4int copy_no,
+                             G4VPhysicalVolume* phys) const override;
+
+private:
+  struct Face {
+    G4int first;      ///< index of the first SiPM of the face
+    G4int n_phi;
+    G4int n_rows;
+    G4double radius;
+    G4double pitch;
+    std::vector<G4RotationMatrix*> rot; ///< one per azimuthal index
+  };
+
+  std::vector<Face> faces_;
+  G4int n_sensors_;
+};
+
+inline G4int SiPMRingParameterisation::GetNumberOfSensors() const
+{ return n_sensors_; }
+
+#endif
@@ -35,9 +35,12 @@ SiPMpetVUV::SiPMpetVUV() : GeometryBase(),
                            refr_index_(1.6),
                            eff_(1.),
                            sipm_size_(3. * mm),
+                           window_thickn_(0.6 * mm),
+                           pd_zpos_(0.),
                            sensor_depth_(-1),
                            mother_depth_(0),
-                           naming_order_(0)
+                           naming_order_(0),
+                           id_offset_(0)
 {
   /// Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/SiPMpet/",
@@ -83,7 +86,7 @@ void SiPMpetVUV::Construct()
 
   // QUARTZ WINDOW
 
-  G4double window_thickness = 0.6 * mm;
+  G4double window_thickness = window_thickn_;
   G4Box* window_solid_vol =
       new G4Box("SIPM_WNDW", sipm_size_/2., sipm_size_/2., window_thickness/2.);
 
@@ -111,8 +114,8 @@ void SiPMpetVUV::Construct()
   G4LogicalVolume* active_logic =
       new G4LogicalVolume(active_solid, silicon, "PHOTODIODES");
 
-  new G4PVPlacement(0, G4ThreeVector(0., 0., sipm_z/2. - window_thickness -
-                                     active_depth/2.),
+  pd_zpos_ = sipm_z/2. - window_thickness - active_depth/2.;
+  new G4PVPlacement(0, G4ThreeVector(0., 0., pd_zpos_),
                     active_logic, "PHOTODIODES", sipm_logic, false, 0, true);
 
   // OPTICAL SURFACES //////////////////////////////////////////////
@@ -160,6 +163,7 @@ void SiPMpetVUV::Construct()
     sipmsd->SetDetectorVolumeDepth(sensor_depth_);
     sipmsd->SetMotherVolumeDepth(mother_depth_);
     sipmsd->SetDetectorNamingOrder(naming_order_);
+    sipmsd->SetDetectorIdOffset(id_offset_);
     G4SDManager::GetSDMpointer()->AddNewDetector(sipmsd);
     active_logic->SetSensitiveDetector(sipmsd);
   }
@@ -32,6 +32,17 @@ public:
   void SetSensorDepth(G4int sensor_depth);
   void SetMotherDepth(G4int mother_depth);
   void SetNamingOrder(G4int naming_order);
+  /// Offset added to the copy number of the SiPM to get its ID
+  void SetIdOffset(G4int id_offset);
+
+  /// Photon detection efficiency
+  G4double GetEfficiency() const;
+  /// Refractive index of the window
+  G4double GetWindowRefractiveIndex() const;
+  /// Thickness of the window
+  G4double GetWindowThickness() const;
+  /// Position along z of the photodiodes in the SiPM frame
+  G4double GetPhotodiodeZ() const;
 
 private:
   // Visibility of the tracking plane
@@ -47,7 +58,10 @@ private:
   G4GenericMessenger *msg_;
 
   G4double sipm_size_;
+  G4double window_thickn_;
+  G4double pd_zpos_;
   G4int sensor_depth_, mother_depth_, naming_order_;
+  G4int id_offset_;
 };
 
 inline void SiPMpetVUV::SetSensorDepth(G4int sensor_depth)
@@ -65,4 +79,23 @@ inline void SiPMpetVUV::SetNamingOrder(G4int naming_order)
   naming_order_ = naming_order;
 }
 
+inline void SiPMpetVUV::SetIdOffset(G4int id_offset)
+{
+  id_offset_ = id_offset;
+}
+
+inline G4double SiPMpetVUV::GetEfficiency() const { return eff_; }
+
+inline G4double SiPMpetVUV::GetWindowRefractiveIndex() const
+{
+  return refr_index_;
+}
+
+inline G4double SiPMpetVUV::GetWindowThickness() const
+{
+  return window_thickn_;
+}
+
+inline G4double SiPMpetVUV::GetPhotodiodeZ() const { return pd_zpos_; }
+
 #endif
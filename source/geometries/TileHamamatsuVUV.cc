@@ -103,7 +103,9 @@ void TileHamamatsuVUV::Construct()
   G4Box* lxe_solid = new G4Box("TILE_LXE", lxe_x/2., lxe_y/2., lxe_z/2.);
 
   G4Material* LXe = G4NistManager::Instance()->FindOrBuildMaterial("G4_lXe");
-  LXe->SetMaterialPropertiesTable(opticalprops::LXe());
+  LXe->SetMaterialPropertiesTable(
+    petopticalprops::Memoize("nexus::LXe", {},
+                             [] { return opticalprops::LXe(); }));
   G4LogicalVolume *lxe_logic =
       new G4LogicalVolume(lxe_solid, LXe, "TILE_LXE");
 
@@ -0,0 +1,179 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelizedPhantom.cc
+//
+// Phantom built from medical images: a map of attenuation coefficients
+// at 511 keV defines the material of each voxel, and a map of activity
+// on the same grid defines the distribution of the generated vertices.
+// The voxels are placed with G4PhantomParameterisation, so that Geant4
+// navigates them with G4RegularNavigation.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VoxelizedPhantom.h"
+#include "VoxelImage.h"
+
+#include "nexus/FactoryBase.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4NistManager.hh>
+#include <G4PhantomParameterisation.hh>
+#include <G4PVParameterised.hh>
+#include <G4VisAttributes.hh>
+#include <Randomize.hh>
+
+#include <cfloat>
+
+using namespace nexus;
+
+REGISTER_CLASS(VoxelizedPhantom, GeometryBase)
+
+VoxelizedPhantom::VoxelizedPhantom(): GeometryBase(),
+                                      attenuation_file_(""),
+                                      activity_file_(""),
+                                      nx_(0), ny_(0), nz_(0),
+                                      material_ids_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/Geometry/VoxelizedPhantom/",
+                                "Control commands of geometry VoxelizedPhantom.");
+  msg_->DeclareProperty("attenuation_file", attenuation_file_,
+                        "Map of attenuation coefficients at 511 keV, in 1/cm (.nii or raw float32).");
+  msg_->DeclareProperty("activity_file", activity_file_,
+                        "Map of activity, on the same grid (.nii or raw float32).");
+  msg_->DeclareProperty("voxels", n_voxels_,
+                        "Number of voxels along x, y, z (raw files only).");
+  msg_->DeclarePropertyWithUnit("voxel_size", "mm", voxel_size_,
+                                "Size of the voxels (raw files only).");
+}
+
+
+
+VoxelizedPhantom::~VoxelizedPhantom()
+{
+  delete msg_;
+  delete[] material_ids_;
+}
+
+
+
+void VoxelizedPhantom::Construct()
+{
+  // Materials, ordered by attenuation coefficient at 511 keV
+  G4NistManager* nist = G4NistManager::Instance();
+  materials_ = {nist->FindOrBuildMaterial("G4_AIR"),
+                nist->BuildMaterialWithNewDensity("PHANTOM_LUNG", "G4_LUNG_ICRP",
+                                                  0.3 * g/cm3),
+                nist->FindOrBuildMaterial("G4_ADIPOSE_TISSUE_ICRP"),
+                nist->FindOrBuildMaterial("G4_TISSUE_SOFT_ICRP"),
+                nist->FindOrBuildMaterial("G4_BONE_CORTICAL_ICRP")};
+  mu_limits_ = {0.02/cm, 0.07/cm, 0.093/cm, 0.11/cm, DBL_MAX};
+
+  VoxelImage image;
+  image.Read(attenuation_file_, (G4int)n_voxels_.x(), (G4int)n_voxels_.y(),
+             (G4int)n_voxels_.z(), voxel_size_);
+  nx_ = image.GetNx();
+  ny_ = image.GetNy();
+  nz_ = image.GetNz();
+  half_voxel_ = image.GetVoxelSize() / 2.;
+
+  BuildMaterialIndices(image);
+
+  // Container of the voxels
+  auto phantom_solid =
+    new G4Box("VPHANTOM", nx_ * half_voxel_.x(), ny_ * half_voxel_.y(),
+              nz_ * half_voxel_.z());
+  auto phantom_logic =
+    new G4LogicalVolume(phantom_solid, materials_[0], "VPHANTOM");
+  this->SetLogicalVolume(phantom_logic);
+
+  auto voxel_solid =
+    new G4Box("VOXEL", half_voxel_.x(), half_voxel_.y(), half_voxel_.z());
+  auto voxel_logic =
+    new G4LogicalVolume(voxel_solid, materials_[0], "VOXEL");
+  voxel_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+
+  auto param = new G4PhantomParameterisation();
+  param->SetVoxelDimensions(half_voxel_.x(), half_voxel_.y(), half_voxel_.z());
+  param->SetNoVoxels(nx_, ny_, nz_);
+  param->SetMaterials(materials_);
+  param->SetMaterialIndices(material_ids_);
+  param->BuildContainerSolid(phantom_solid);
+
+  G4PVParameterised* voxel_phys =
+    new G4PVParameterised("VOXEL", voxel_logic, phantom_logic, kUndefined,
+                          param->GetNoVoxels(), param);
+  // Use G4RegularNavigation
+  voxel_phys->SetRegularStructureId(1);
+
+  // Activity
+  VoxelImage activity;
+  activity.Read(activity_file_, (G4int)n_voxels_.x(), (G4int)n_voxels_.y(),
+                (G4int)n_voxels_.z(), voxel_size_);
+  if (activity.GetNx() != nx_ || activity.GetNy() != ny_ ||
+      activity.GetNz() != nz_)
+    G4Exception("[VoxelizedPhantom]", "Construct()", FatalException,
+                "Activity and attenuation maps with different number of voxels.");
+
+  BuildActivitySampler(activity);
+
+  G4cout << "*** Voxelized phantom of (" << nx_ << ", " << ny_ << ", "
+         << nz_ << ") voxels of " << image.GetVoxelSize() / mm << " mm, "
+         << active_voxels_.size() << " with activity ***" << G4endl;
+}
+
+
+
+void VoxelizedPhantom::BuildMaterialIndices(const VoxelImage& image)
+{
+  const std::vector<G4float>& mu = image.GetData();
+
+  delete[] material_ids_;
+  material_ids_ = new size_t[mu.size()];
+
+  for (size_t i=0; i<mu.size(); i++) {
+    G4double value = mu[i] / cm;
+    size_t m = 0;
+    while (m < mu_limits_.size() - 1 && value >= mu_limits_[m]) m++;
+    material_ids_[i] = m;
+  }
+}
+
+
+
+void VoxelizedPhantom::BuildActivitySampler(const VoxelImage& image)
+{
+  const std::vector<G4float>& activity = image.GetData();
+
+  // Only voxels with activity enter the alias table
+  active_voxels_.clear();
+  std::vector<G4double> weights;
+  for (size_t i=0; i<activity.size(); i++) {
+    if (activity[i] > 0.) {
+      active_voxels_.push_back(i);
+      weights.push_back(activity[i]);
+    }
+  }
+
+  voxel_sampler_.SetWeights(weights);
+}
+
+
+
+G4ThreeVector VoxelizedPhantom::GenerateVertex(const G4String& /*region*/) const
+{
+  unsigned int voxel = active_voxels_[voxel_sampler_.Sample()];
+
+  G4int ix = voxel % nx_;
+  G4int iy = (voxel / nx_) % ny_;
+  G4int iz = voxel / (nx_ * ny_);
+
+  // Uniform point inside the voxel
+  G4double x = (2 * (ix + G4UniformRand()) - nx_) * half_voxel_.x();
+  G4double y = (2 * (iy + G4UniformRand()) - ny_) * half_voxel_.y();
+  G4double z = (2 * (iz + G4UniformRand()) - nz_) * half_voxel_.z();
+
+  return G4ThreeVector(x, y, z);
+}
@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelizedPhantom.h
+//
+// Phantom built from medical images: a map of attenuation coefficients
+// at 511 keV defines the material of each voxel, and a map of activity
+// on the same grid defines the distribution of the generated vertices.
+// The voxels are placed with G4PhantomParameterisation, so that Geant4
+// navigates them with G4RegularNavigation.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VOXELIZED_PHANTOM_H
+#define VOXELIZED_PHANTOM_H
+
+#include "AliasSampler.h"
+
+#include "nexus/GeometryBase.h"
+
+#include <vector>
+
+class G4GenericMessenger;
+class G4Material;
+class VoxelImage;
+
+using namespace nexus;
+
+class VoxelizedPhantom: public GeometryBase
+{
+public:
+  VoxelizedPhantom();
+  ~VoxelizedPhantom();
+
+  void Construct();
+
+  /// Generate a vertex following the activity map
+  G4ThreeVector GenerateVertex(const G4String& region) const;
+
+private:
+  /// Assign a material to each voxel from its attenuation coefficient
+  void BuildMaterialIndices(const VoxelImage& image);
+  /// Build the table used to choose the voxel of each vertex
+  void BuildActivitySampler(const VoxelImage& image);
+
+  G4GenericMessenger* msg_;
+
+  G4String attenuation_file_; ///< Map of attenuation coefficients (1/cm)
+  G4String activity_file_;    ///< Map of activity
+  G4ThreeVector n_voxels_;    ///< Number of voxels, for raw files only
+  G4ThreeVector voxel_size_;  ///< Size of the voxels, for raw files only
+
+  G4int nx_, ny_, nz_;
+  G4ThreeVector half_voxel_;
+
+  std::vector<G4Material*> materials_;
+  /// Upper limit of the attenuation coefficient of each material
+  std::vector<G4double> mu_limits_;
+  size_t* material_ids_; ///< Material of each voxel, used by Geant4
+
+  std::vector<unsigned int> active_voxels_; ///< Voxels with activity
+  AliasSampler voxel_sampler_;
+};
+
+#endif
@@ -14,16 +14,59 @@
 #include "nexus/OpticalMaterialProperties.h"
 
 #include <G4MaterialPropertiesTable.hh>
+#include <G4AutoLock.hh>
 
 #include <cassert>
+#include <map>
 
 using namespace nexus;
 using namespace CLHEP;
 
+namespace {
+
+  // Tables already built, by name and parameters
+  using TableKey = std::pair<G4String, std::vector<G4double>>;
+  std::map<TableKey, G4MaterialPropertiesTable*> tables;
+  G4Mutex tablesMutex = G4MUTEX_INITIALIZER;
+
+  G4MaterialPropertiesTable* Find(const G4String& name,
+                                  const std::vector<G4double>& params)
+  {
+    G4AutoLock l(&tablesMutex);
+    auto it = tables.find(TableKey(name, params));
+    return it == tables.end() ? nullptr : it->second;
+  }
+
+  G4MaterialPropertiesTable* Store(const G4String& name,
+                                   const std::vector<G4double>& params,
+                                   G4MaterialPropertiesTable* mpt)
+  {
+    G4AutoLock l(&tablesMutex);
+    auto result = tables.emplace(TableKey(name, params), mpt);
+    // Another thread built the same table in the meantime
+    if (!result.second) delete mpt;
+    return result.first->second;
+  }
+
+} // namespace
+
 namespace petopticalprops {
 
+G4MaterialPropertiesTable* Memoize(const G4String& name,
+                                   const std::vector<G4double>& params,
+                                   const std::function<G4MaterialPropertiesTable*()>& build)
+{
+  G4MaterialPropertiesTable* mpt = Find(name, params);
+  if (mpt) return mpt;
+  return Store(name, params, build());
+}
+
+
+
 G4MaterialPropertiesTable* Epoxy()
 {
+  if (auto cached = Find("Epoxy", {})) return cached;
+
   // Optical properties of Epoxy adhesives.
   // Obtained from
   // http://www.epotek.com/SSCDocs/techtips/Tech%20Tip%2018%20-%20Understanding%20Optical%20Properties%20for%20Epoxy%20Apps.pdf
@@ -48,11 +91,13 @@ G4MaterialPropertiesTable* Epoxy()
 
   mpt->AddProperty("ABSLENGTH", abs_energy, abs_length);
 
-  return mpt;
+  return Store("Epoxy", {}, mpt);
 }
 
 G4MaterialPropertiesTable* EpoxyFixedRefr(G4double n)
 {
+  if (auto cached = Find("EpoxyFixedRefr", {n})) return cached;
+
   // Costum refractive index.
 
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
@@ -71,11 +116,13 @@ G4MaterialPropertiesTable* EpoxyFixedRefr(G4double n)
 
   mpt->AddProperty("ABSLENGTH", abs_energy, abs_length);
 
-  return mpt;
+  return Store("EpoxyFixedRefr", {n}, mpt);
 }
 
 G4MaterialPropertiesTable* EpoxyLXeRefr()
 {
+  if (auto cached = Find("EpoxyLXeRefr", {})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   const G4int ri_entries = 200;
@@ -102,12 +149,14 @@ G4MaterialPropertiesTable* EpoxyLXeRefr()
     {opticalprops::noAbsLength_, opticalprops::noAbsLength_};
   mpt->AddProperty("ABSLENGTH", abs_energy, abs_length);
 
-  return mpt;
+  return Store("EpoxyLXeRefr", {}, mpt);
 }
 
 
 G4MaterialPropertiesTable* FakeGenericMaterial(G4double quartz_rindex)
 {
+  if (auto cached = Find("FakeGenericMaterial", {quartz_rindex})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   std::vector<G4double> energy =
@@ -122,12 +171,14 @@ G4MaterialPropertiesTable* FakeGenericMaterial(G4double quartz_rindex)
     {opticalprops::noAbsLength_, opticalprops::noAbsLength_};
   mpt->AddProperty("ABSLENGTH", energy, abs_length);
 
-  return mpt;
+  return Store("FakeGenericMaterial", {quartz_rindex}, mpt);
 }
 
 
 G4MaterialPropertiesTable* GlassEpoxy()
 {
+  if (auto cached = Find("GlassEpoxy", {})) return cached;
+
  // WARNING: This is a deprecated optical property, it is kept for code consistency, but it
  // will be removed in the future.
  // Optical properties of Optorez 1330 glass epoxy.
@@ -168,12 +219,14 @@ G4MaterialPropertiesTable* GlassEpoxy()
      0.10*mm, 0.10*mm};
   mpt->AddProperty("ABSLENGTH", abs_energy, abs_length);
 
-  return mpt;
+  return Store("GlassEpoxy", {}, mpt);
 }
 
 
   G4MaterialPropertiesTable* LXe(G4double pressure)
   {
+    if (auto cached = Find("LXe", {pressure})) return cached;
+
     /// The time constants are taken from E. Hogenbirk et al 2018 JINST 13 P10031
     G4MaterialPropertiesTable* LXe_mpt = new G4MaterialPropertiesTable();
 
@@ -244,13 +297,15 @@ G4MaterialPropertiesTable* GlassEpoxy()
 
     LXe_mpt->AddProperty("RAYLEIGH", rayleigh_energy, rayleigh_length);
 
-    return LXe_mpt;
+    return Store("LXe", {pressure}, LXe_mpt);
   }
 
 
 
 G4MaterialPropertiesTable* LXe_nconst()
 {
+  if (auto cached = Find("LXe_nconst", {})) return cached;
+
   G4MaterialPropertiesTable* LXe_mpt = new G4MaterialPropertiesTable();
 
   std::vector<G4double> ri_energy =
@@ -297,13 +352,15 @@ G4MaterialPropertiesTable* LXe_nconst()
   LXe_mpt->AddConstProperty("SCINTILLATIONYIELD2", .971);
   LXe_mpt->AddConstProperty("ATTACHMENT", 1000.*ms, 1);
 
-  return LXe_mpt;
+  return Store("LXe_nconst", {}, LXe_mpt);
 }
 
 
 
 G4MaterialPropertiesTable* Pyrex_vidrasa()
 {
+  if (auto cached = Find("Pyrex_vidrasa", {})) return cached;
+
   G4MaterialPropertiesTable* pyrex_mpt = new G4MaterialPropertiesTable();
 
   // Refractive index and absorption lenth taken from:
@@ -332,12 +389,14 @@ G4MaterialPropertiesTable* Pyrex_vidrasa()
 
   pyrex_mpt->AddProperty("ABSLENGTH", ri_energy, abs_length);
 
-  return pyrex_mpt;
+  return Store("Pyrex_vidrasa", {}, pyrex_mpt);
 }
 
 /// PTFE (== TEFLON) ///
 G4MaterialPropertiesTable* PTFE()
 {
+  if (auto cached = Find("PTFE", {})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   // REFLECTIVITY IN LXE
@@ -362,13 +421,15 @@ G4MaterialPropertiesTable* PTFE()
   mpt->AddProperty("SPECULARSPIKECONSTANT",ENERGIES, specularspike);
   mpt->AddProperty("BACKSCATTERCONSTANT",  ENERGIES, backscatter);
 
-  return mpt;
+  return Store("PTFE", {}, mpt);
 }
 
 
 
 G4MaterialPropertiesTable* TPB(G4double decay_time)
 {
+  if (auto cached = Find("TPB", {decay_time})) return cached;
+
 
   /// This is the simulation of the optical properties of TPB (tetraphenyl butadiene)
   /// a wavelength shifter which allows to converts VUV photons to blue photons.
@@ -458,12 +519,14 @@ G4MaterialPropertiesTable* TPB(G4double decay_time)
   mpt->AddConstProperty("WLSMEANNUMBERPHOTONS", 0.65);
   //mpt->AddConstProperty("WLSTIMECONSTANT",2.2*ns);
 
-  return mpt;
+  return Store("TPB", {decay_time}, mpt);
 }
 
 
 G4MaterialPropertiesTable* TPB_LXe(G4double decay_time)
 {
+  if (auto cached = Find("TPB_LXe", {decay_time})) return cached;
+
   /// This is the simulation of the optical properties of TPB
   /// (tetraphenyl butadiene), a wavelength shifter which allows one
   /// to convert VUV photons to blue photons.
@@ -567,12 +630,14 @@ G4MaterialPropertiesTable* TPB_LXe(G4double decay_time)
   mpt->AddConstProperty("WLSMEANNUMBERPHOTONS", 0.65);
   //mpt->AddConstProperty("WLSTIMECONSTANT",2.2*ns);
 
-  return mpt;
+  return Store("TPB_LXe", {decay_time}, mpt);
 }
 
 
 G4MaterialPropertiesTable* TPB_LXe_nconst(G4double decay_time)
 {
+  if (auto cached = Find("TPB_LXe_nconst", {decay_time})) return cached;
+
   /// This is the simulation of the optical properties of TPB
   /// (tetraphenyl butadiene), a wavelength shifter which allows one
   /// to convert VUV photons to blue photons.
@@ -664,12 +729,14 @@ G4MaterialPropertiesTable* TPB_LXe_nconst(G4double decay_time)
   mpt->AddConstProperty("WLSMEANNUMBERPHOTONS", 0.65);
   //mpt->AddConstProperty("WLSTIMECONSTANT",2.2*ns);
 
-  return mpt;
+  return Store("TPB_LXe_nconst", {decay_time}, mpt);
 }
 
 
 G4MaterialPropertiesTable* LYSO()
 {
+  if (auto cached = Find("LYSO", {})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   G4double const lyso_minE = 1.9630 * eV; // this value should be changed to the lower limit of detection of the specific photosensor used
@@ -758,11 +825,13 @@ G4MaterialPropertiesTable* LYSO()
   std::vector<G4double> rayleigh_length = {260.*cm, 260.*cm};
   mpt->AddProperty("RAYLEIGH", rayleigh_energy, rayleigh_length);
 
-  return mpt;
+  return Store("LYSO", {}, mpt);
 }
 
 G4MaterialPropertiesTable* LYSO_nconst()
 {
+  if (auto cached = Find("LYSO_nconst", {})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   G4double const lyso_minE = 1.9630 * eV; // this value should be changed to the lower limit of detection of the specific photosensor used
@@ -837,12 +906,14 @@ G4MaterialPropertiesTable* LYSO_nconst()
   mpt->AddProperty("RAYLEIGH", rayleigh_energy, rayleigh_length);
 
 
-  return mpt;
+  return Store("LYSO_nconst", {}, mpt);
 }
 
 
 G4MaterialPropertiesTable* ReflectantSurface(G4double reflectivity)
 {
+  if (auto cached = Find("ReflectantSurface", {reflectivity})) return cached;
+
   G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
   std::vector<G4double> ENERGIES =
@@ -863,7 +934,7 @@ G4MaterialPropertiesTable* ReflectantSurface(G4double reflectivity)
   mpt->AddProperty("SPECULARSPIKECONSTANT", ENERGIES, specularspike);
   mpt->AddProperty("BACKSCATTERCONSTANT", ENERGIES, backscatter);
 
-  return mpt;
+  return Store("ReflectantSurface", {reflectivity}, mpt);
 }
 
 }
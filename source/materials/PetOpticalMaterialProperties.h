@@ -13,14 +13,25 @@
 
 #include <CLHEP/Units/PhysicalConstants.h>
 
+#include <functional>
+#include <vector>
+
 class G4MaterialPropertiesTable;
 
 using namespace CLHEP;
 
-/// This is a stateless class where all methods are static functions.
+/// Each table is built the first time it is requested with some parameters,
+/// and the same table is returned by later calls with the same parameters.
+/// Tables are therefore shared and must not be modified by the callers.
 
 namespace petopticalprops
 {
+  /// Return the table built by build() the first time it is called
+  /// with the same name and parameters (e.g., for the nexus tables)
+  G4MaterialPropertiesTable* Memoize(const G4String& name,
+                                     const std::vector<G4double>& params,
+                                     const std::function<G4MaterialPropertiesTable*()>& build);
+
   G4MaterialPropertiesTable* Epoxy();
   G4MaterialPropertiesTable* GlassEpoxy();
   G4MaterialPropertiesTable* EpoxyFixedRefr(G4double n);
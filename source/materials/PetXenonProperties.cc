@@ -9,6 +9,7 @@
 #include "PetXenonProperties.h"
 
 #include <G4SystemOfUnits.hh>
+#include <algorithm>
 #include <fstream>
 
 
@@ -58,33 +59,30 @@ G4double GetLXeDensity(G4double pressure)
   // Interpolate to calculate the density at a given pressure.
   // The temperature is unique, given the pressure, and it follows the liquid-vapor
   // saturation curve of liquid xenon.
-  G4double density = 5.324 * kg/m3;
-  std::vector<std::vector<G4double>> data;
-  G4int n_keys = MakeLXeDensityDataTable(data);
-
-  // Use linear interpolation
-  G4bool found = false;
-
-  for (G4int i=0; i<n_keys-1; ++i) {
-    if (pressure >= data[i][1] && pressure < data[i+1][1]) {
-      G4double x1 = data[i][1];
-      G4double x2 = data[i+1][1];
-      G4double y1 = data[i][2];
-      G4double y2 = data[i+1][2];
-      density = y1 + (y2-y1)*(pressure-x1)/(x2-x1);
-      found = true;
-      break;
-    }
-  }
-
-  if (!found) {
-    if (pressure == data[n_keys-1][1]) {
-      density = data[n_keys-1][2];
-    }
-    else {
-      throw "Unknown xenon density for this pressure!";
-    }
-  }
-
-  return density;
+  // The table is read only once, and sorted by pressure.
+  static const std::vector<std::pair<G4double, G4double>> table = [] {
+    std::vector<std::vector<G4double>> data;
+    MakeLXeDensityDataTable(data);
+    std::vector<std::pair<G4double, G4double>> t;
+    for (auto& d: data) t.emplace_back(d[1], d[2]);
+    std::sort(t.begin(), t.end());
+    return t;
+  }();
+
+  if (table.empty() || !(pressure >= table.front().first &&
+                          pressure <= table.back().first))
+    throw "Unknown xenon density for this pressure!";
+
+  if (pressure == table.back().first)
+    return table.back().second;
+
+  // Use linear interpolation between the points around the pressure
+  auto it = std::upper_bound(table.begin(), table.end(), pressure,
+                             [](G4double p, const std::pair<G4double, G4double>& e)
+                             { return p < e.first; });
+  G4double x1 = (it-1)->first;
+  G4double x2 = it->first;
+  G4double y1 = (it-1)->second;
+  G4double y2 = it->second;
+  return y1 + (y2-y1)*(pressure-x1)/(x2-x1);
 }
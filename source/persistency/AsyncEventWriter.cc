@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+// petalosim | AsyncEventWriter.cc
+//
+// Writes the events to the output file from a dedicated thread.
+// Each thread processing events fills its own event buffers and hands them
+// to the writer through its own lock-free single-producer queue; the filled
+// buffers are returned to the same thread through a second queue to be
+// reused. Events are written in order of arrival; every row carries the
+// event ID.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "AsyncEventWriter.h"
+#include "HDF5Writer.h"
+
+#include <chrono>
+
+namespace {
+
+  std::atomic<unsigned int> n_writers(0);
+
+  // Producer of the calling thread for the writer with the given id
+  struct ProducerCache {
+    unsigned int id;
+    void* producer;
+  };
+  thread_local ProducerCache producer_cache = {0, 0};
+
+  const std::chrono::microseconds idle_wait(100);
+
+}
+
+
+
+AsyncEventWriter::Producer::Producer(size_t queue_size):
+  full(queue_size), empty(queue_size + 2)
+{
+}
+
+
+
+AsyncEventWriter::AsyncEventWriter(HDF5Writer* writer, size_t queue_size):
+  writer_(writer), queue_size_(queue_size), id_(++n_writers),
+  stop_(false), n_pushed_(0), n_written_(0)
+{
+  thread_ = std::thread(&AsyncEventWriter::Run, this);
+}
+
+
+
+AsyncEventWriter::~AsyncEventWriter()
+{
+  stop_ = true;
+  thread_.join();
+}
+
+
+
+AsyncEventWriter::Producer* AsyncEventWriter::GetProducer()
+{
+  if (producer_cache.id == id_)
+    return static_cast<Producer*>(producer_cache.producer);
+
+  std::lock_guard<std::mutex> lock(producers_mutex_);
+  producers_.emplace_back(new Producer(queue_size_));
+  producer_cache.id       = id_;
+  producer_cache.producer = producers_.back().get();
+  return producers_.back().get();
+}
+
+
+
+EventBuffer* AsyncEventWriter::GetBuffer()
+{
+  Producer* p = GetProducer();
+
+  EventBuffer* buffer = 0;
+  if (p->empty.Pop(buffer))
+    return buffer;
+
+  // No buffer returned yet by the writer thread: create a new one.
+  // At most queue_size + 2 buffers are created per producer.
+  p->buffers.emplace_back(new EventBuffer());
+  return p->buffers.back().get();
+}
+
+
+
+void AsyncEventWriter::Push(EventBuffer* buffer)
+{
+  Producer* p = GetProducer();
+  n_pushed_++;
+  while (!p->full.Push(buffer))
+    std::this_thread::yield();
+}
+
+
+
+void AsyncEventWriter::Flush()
+{
+  while (n_written_ < n_pushed_)
+    std::this_thread::sleep_for(idle_wait);
+}
+
+
+
+bool AsyncEventWriter::WritePending()
+{
+  std::vector<Producer*> producers;
+  {
+    std::lock_guard<std::mutex> lock(producers_mutex_);
+    for (auto& p : producers_)
+      producers.push_back(p.get());
+  }
+
+  bool written = false;
+  for (Producer* p : producers) {
+    EventBuffer* buffer = 0;
+    while (p->full.Pop(buffer)) {
+      writer_->WriteEvent(*buffer);
+      buffer->Clear();
+      p->empty.Push(buffer);
+      n_written_++;
+      written = true;
+    }
+  }
+
+  return written;
+}
+
+
+
+void AsyncEventWriter::Run()
+{
+  while (true) {
+    // Read the flag before emptying the queues, so that all the events
+    // pushed before the stop request are written
+    bool stop = stop_;
+    if (!WritePending()) {
+      if (stop) break;
+      std::this_thread::sleep_for(idle_wait);
+    }
+  }
+}
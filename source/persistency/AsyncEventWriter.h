@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------------
+// petalosim | AsyncEventWriter.h
+//
+// Writes the events to the output file from a dedicated thread.
+// Each thread processing events fills its own event buffers and hands them
+// to the writer through its own lock-free single-producer queue; the filled
+// buffers are returned to the same thread through a second queue to be
+// reused. Events are written in order of arrival; every row carries the
+// event ID.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ASYNC_EVENT_WRITER_H
+#define ASYNC_EVENT_WRITER_H
+
+#include "EventBuffer.h"
+#include "SPSCQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class HDF5Writer;
+
+class AsyncEventWriter
+{
+public:
+  /// Constructor. The writer thread starts right away; up to queue_size
+  /// events per producer thread can be waiting to be written.
+  AsyncEventWriter(HDF5Writer* writer, size_t queue_size);
+  /// Destructor. Writes the pending events and stops the writer thread.
+  ~AsyncEventWriter();
+
+  /// Empty buffer to be filled by the calling thread with its next event
+  EventBuffer* GetBuffer();
+  /// Hand a buffer filled by the calling thread to the writer thread.
+  /// Waits only if the queue of the calling thread is full.
+  void Push(EventBuffer* buffer);
+
+  /// Wait until all the events pushed so far have been written
+  void Flush();
+
+private:
+  /// Queues and buffers of one producer thread
+  struct Producer
+  {
+    Producer(size_t queue_size);
+    SPSCQueue<EventBuffer*> full;  ///< producer -> writer
+    SPSCQueue<EventBuffer*> empty; ///< writer -> producer
+    std::vector<std::unique_ptr<EventBuffer>> buffers; ///< owned buffers
+  };
+
+  Producer* GetProducer();
+  /// Write all the events waiting in the queues. Returns false if none.
+  bool WritePending();
+  /// Loop of the writer thread
+  void Run();
+
+  HDF5Writer* writer_;
+  size_t queue_size_;
+  unsigned int id_; ///< distinguishes this writer in the thread-local cache
+
+  std::mutex producers_mutex_; ///< taken only to register a new producer
+  std::vector<std::unique_ptr<Producer>> producers_;
+
+  std::atomic<bool> stop_;
+  std::atomic<unsigned long> n_pushed_;
+  std::atomic<unsigned long> n_written_;
+
+  std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,214 @@
+// ----------------------------------------------------------------------------
+// petalosim | EventBuffer.cc
+//
+// Rows of the h5 tables produced by one event, kept in memory so that
+// each table is written with a single call once the event is complete.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "EventBuffer.h"
+
+#include <cstring>
+
+
+EventBuffer::EventBuffer()
+{
+}
+
+
+
+EventBuffer::~EventBuffer()
+{
+}
+
+
+
+void EventBuffer::AddSensorData(int evt_number, unsigned int sensor_id,
+                                unsigned int charge)
+{
+  sns_data_t snsData;
+  snsData.event_id = evt_number;
+  snsData.sensor_id = sensor_id;
+  snsData.charge = charge;
+  sns_data_.push_back(snsData);
+}
+
+
+
+void EventBuffer::AddSensorTof(int evt_number, int sensor_id, float time,
+                               unsigned int track_id)
+{
+  sns_tof_t snsTof;
+  snsTof.event_id = evt_number;
+  snsTof.sensor_id = sensor_id;
+  snsTof.time = time;
+  snsTof.track_id = track_id;
+  sns_tof_.push_back(snsTof);
+}
+
+
+
+void EventBuffer::AddHit(int evt_number, int particle_indx,
+                         float hit_position_x, float hit_position_y,
+                         float hit_position_z, float hit_time,
+                         float hit_energy, const char* label)
+{
+  hit_info_t trueInfo;
+  trueInfo.event_id = evt_number;
+  memset(trueInfo.label, 0, STRLEN);
+  trueInfo.x = hit_position_x;
+  trueInfo.y = hit_position_y;
+  trueInfo.z = hit_position_z;
+  trueInfo.time = hit_time;
+  trueInfo.energy = hit_energy;
+  strcpy(trueInfo.label, label);
+  trueInfo.particle_id = particle_indx;
+  hits_.push_back(trueInfo);
+}
+
+
+
+void EventBuffer::AddParticle(int evt_number, int particle_indx,
+                              const char* particle_name, char primary,
+                              int mother_id, float initial_vertex_x,
+                              float initial_vertex_y,
+                              float initial_vertex_z,
+                              float initial_vertex_t,
+                              float final_vertex_x,
+                              float final_vertex_y, float final_vertex_z,
+                              float final_vertex_t,
+                              const char* initial_volume,
+                              const char* final_volume, float momentum_x,
+                              float momentum_y, float momentum_z,
+                              float final_momentum_x,
+                              float final_momentum_y,
+                              float final_momentum_z, float kin_energy,
+                              float length, const char* creator_proc,
+                              const char* final_proc)
+{
+  particle_info_t trueInfo;
+  trueInfo.event_id = evt_number;
+  trueInfo.particle_id = particle_indx;
+  memset(trueInfo.particle_name, 0, STRLEN);
+  strcpy(trueInfo.particle_name, particle_name);
+  trueInfo.primary = primary;
+  trueInfo.mother_id = mother_id;
+  trueInfo.initial_x = initial_vertex_x;
+  trueInfo.initial_y = initial_vertex_y;
+  trueInfo.initial_z = initial_vertex_z;
+  trueInfo.initial_t = initial_vertex_t;
+  trueInfo.final_x = final_vertex_x;
+  trueInfo.final_y = final_vertex_y;
+  trueInfo.final_z = final_vertex_z;
+  trueInfo.final_t = final_vertex_t;
+  memset(trueInfo.initial_volume, 0, STRLEN);
+  strcpy(trueInfo.initial_volume, initial_volume);
+  memset(trueInfo.final_volume, 0, STRLEN);
+  strcpy(trueInfo.final_volume, final_volume);
+  trueInfo.initial_momentum_x = momentum_x;
+  trueInfo.initial_momentum_y = momentum_y;
+  trueInfo.initial_momentum_z = momentum_z;
+  trueInfo.final_momentum_x = final_momentum_x;
+  trueInfo.final_momentum_y = final_momentum_y;
+  trueInfo.final_momentum_z = final_momentum_z;
+  trueInfo.kin_energy = kin_energy;
+  trueInfo.length = length;
+  memset(trueInfo.creator_proc, 0, STRLEN);
+  strcpy(trueInfo.creator_proc, creator_proc);
+  memset(trueInfo.final_proc, 0, STRLEN);
+  strcpy(trueInfo.final_proc, final_proc);
+  particles_.push_back(trueInfo);
+}
+
+
+
+void EventBuffer::AddSensorPos(unsigned int sensor_id,
+                               const char* sensor_name, float x, float y,
+                               float z)
+{
+  sns_pos_t snsPos;
+  snsPos.sensor_id = sensor_id;
+  memset(snsPos.sensor_name, 0, STRLEN);
+  strcpy(snsPos.sensor_name, sensor_name);
+  snsPos.x = x;
+  snsPos.y = y;
+  snsPos.z = z;
+  sns_pos_.push_back(snsPos);
+}
+
+
+
+void EventBuffer::AddStep(int evt_number,
+                          int particle_id, const char* particle_name,
+                          int step_id,
+                          const char* initial_volume,
+                          const char*   final_volume,
+                          const char*      proc_name,
+                          float initial_x, float initial_y, float initial_z,
+                          float   final_x, float   final_y, float   final_z)
+{
+  step_info_t step;
+  step.event_id    = evt_number;
+  step.particle_id = particle_id;
+  memset(step.particle_name , 0,  STRLEN);
+  strcpy(step.particle_name ,  particle_name);
+  step.step_id    = step_id;
+  memset(step.initial_volume, 0, STRLEN);
+  strcpy(step.initial_volume, initial_volume);
+  memset(step.  final_volume, 0, STRLEN);
+  strcpy(step.  final_volume,   final_volume);
+  memset(step.     proc_name, 0, STRLEN);
+  strcpy(step.     proc_name,      proc_name);
+  step.initial_x   = initial_x;
+  step.initial_y   = initial_y;
+  step.initial_z   = initial_z;
+  step.  final_x   =   final_x;
+  step.  final_y   =   final_y;
+  step.  final_z   =   final_z;
+
+  steps_.push_back(step);
+}
+
+
+
+void EventBuffer::AddChargeData(int evt_number, unsigned int sensor_id,
+                                unsigned int time_bin, unsigned int charge)
+{
+  charge_data_t chargeData;
+  chargeData.event_id = evt_number;
+  chargeData.sensor_id = sensor_id;
+  chargeData.time_bin = time_bin;
+  chargeData.charge = charge;
+  charge_data_.push_back(chargeData);
+}
+
+
+
+void EventBuffer::AddProfile(int evt_number, const char* particle_name,
+                             uint64_t n_tracks, uint64_t n_steps,
+                             float wall_time)
+{
+  profile_t profile;
+  profile.event_id = evt_number;
+  memset(profile.particle_name, 0, STRLEN);
+  strcpy(profile.particle_name, particle_name);
+  profile.n_tracks = n_tracks;
+  profile.n_steps = n_steps;
+  profile.wall_time = wall_time;
+  profile_.push_back(profile);
+}
+
+
+
+void EventBuffer::Clear()
+{
+  sns_data_.clear();
+  sns_tof_.clear();
+  hits_.clear();
+  particles_.clear();
+  sns_pos_.clear();
+  steps_.clear();
+  charge_data_.clear();
+  profile_.clear();
+}
@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// petalosim | EventBuffer.h
+//
+// Rows of the h5 tables produced by one event, kept in memory so that
+// each table is written with a single call once the event is complete.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef EVENT_BUFFER_H
+#define EVENT_BUFFER_H
+
+#include "hdf5_functions.h"
+
+#include <vector>
+
+class EventBuffer
+{
+public:
+  EventBuffer();
+  ~EventBuffer();
+
+  void AddSensorData(int evt_number, unsigned int sensor_id,
+                     unsigned int charge);
+  void AddSensorTof(int evt_number, int sensor_id, float time,
+                    unsigned int track_id);
+  void AddHit(int evt_number, int particle_indx, float hit_position_x,
+              float hit_position_y, float hit_position_z, float hit_time,
+              float hit_energy, const char *label);
+  void AddParticle(int evt_number, int particle_indx,
+                   const char *particle_name, char primary, int mother_id,
+                   float initial_vertex_x, float initial_vertex_y,
+                   float initial_vertex_z, float initial_vertex_t,
+                   float final_vertex_x, float final_vertex_y,
+                   float final_vertex_z, float final_vertex_t,
+                   const char *initial_volume, const char *final_volume,
+                   float momentum_x, float momentum_y, float momentum_z,
+                   float final_momentum_x, float final_momentum_y,
+                   float final_momentum_z, float kin_energy, float length,
+                   const char *creator_proc, const char *final_proc);
+  void AddSensorPos(unsigned int sensor_id, const char *sensor_name,
+                    float x, float y, float z);
+  void AddStep(int evt_number,
+               int particle_id, const char *particle_name,
+               int step_id,
+               const char *initial_volume,
+               const char *final_volume,
+               const char *proc_name,
+               float initial_x, float initial_y, float initial_z,
+               float final_x, float final_y, float final_z);
+  void AddChargeData(int evt_number, unsigned int sensor_id,
+                     unsigned int time_bin, unsigned int charge);
+  void AddProfile(int evt_number, const char *particle_name,
+                  uint64_t n_tracks, uint64_t n_steps, float wall_time);
+
+  /// Remove all the rows, keeping the allocated memory
+  void Clear();
+
+  const std::vector<sns_data_t>&      GetSensorData() const;
+  const std::vector<sns_tof_t>&       GetSensorTof() const;
+  const std::vector<hit_info_t>&      GetHits() const;
+  const std::vector<particle_info_t>& GetParticles() const;
+  const std::vector<sns_pos_t>&       GetSensorPos() const;
+  const std::vector<step_info_t>&     GetSteps() const;
+  const std::vector<charge_data_t>&   GetChargeData() const;
+  const std::vector<profile_t>&       GetProfile() const;
+
+private:
+  std::vector<sns_data_t>      sns_data_;
+  std::vector<sns_tof_t>       sns_tof_;
+  std::vector<hit_info_t>      hits_;
+  std::vector<particle_info_t> particles_;
+  std::vector<sns_pos_t>       sns_pos_;
+  std::vector<step_info_t>     steps_;
+  std::vector<charge_data_t>   charge_data_;
+  std::vector<profile_t>       profile_;
+};
+
+inline const std::vector<sns_data_t>& EventBuffer::GetSensorData() const
+{ return sns_data_; }
+inline const std::vector<sns_tof_t>& EventBuffer::GetSensorTof() const
+{ return sns_tof_; }
+inline const std::vector<hit_info_t>& EventBuffer::GetHits() const
+{ return hits_; }
+inline const std::vector<particle_info_t>& EventBuffer::GetParticles() const
+{ return particles_; }
+inline const std::vector<sns_pos_t>& EventBuffer::GetSensorPos() const
+{ return sns_pos_; }
+inline const std::vector<step_info_t>& EventBuffer::GetSteps() const
+{ return steps_; }
+inline const std::vector<charge_data_t>& EventBuffer::GetChargeData() const
+{ return charge_data_; }
+inline const std::vector<profile_t>& EventBuffer::GetProfile() const
+{ return profile_; }
+
+#endif
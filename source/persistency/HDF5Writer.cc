@@ -20,7 +20,8 @@
 HDF5Writer::HDF5Writer():
   file_(0), irun_(0), ismp_(0),
   ismp_tof_(0), ihit_(0),
-  ipart_(0), ipos_(0), istep_(0), icharge_(0)
+  ipart_(0), ipos_(0), istep_(0), icharge_(0),
+  ilutpt_(0), ilut_(0), isens_(0), iprof_(0)
 {
 }
 
@@ -28,7 +29,8 @@ HDF5Writer::~HDF5Writer()
 {
 }
 
-void HDF5Writer::Open(std::string fileName, bool debug)
+void HDF5Writer::Open(std::string fileName, bool debug, bool lut,
+                      bool sensitivity, bool profile)
 {
   firstEvent_= true;
 
@@ -68,6 +70,29 @@ void HDF5Writer::Open(std::string fileName, bool debug)
   chargeDataTable_ = createTable(group_, charge_data_table_name,
                                  memtypeChargeData_);
 
+  if (lut) {
+    std::string lut_point_table_name = "lut_points";
+    memtypeLUTPoint_ = createLUTPointType();
+    lutPointTable_ = createTable(group_, lut_point_table_name,
+                                 memtypeLUTPoint_);
+
+    std::string lut_table_name = "lut";
+    memtypeLUT_ = createLUTType();
+    lutTable_ = createTable(group_, lut_table_name, memtypeLUT_);
+  }
+
+  if (sensitivity) {
+    std::string sens_table_name = "sensitivity_map";
+    memtypeSens_ = createSensPointType();
+    sensTable_ = createTable(group_, sens_table_name, memtypeSens_);
+  }
+
+  if (profile) {
+    std::string profile_table_name = "profile";
+    memtypeProfile_ = createProfileType();
+    profileTable_ = createTable(group_, profile_table_name, memtypeProfile_);
+  }
+
   if (debug) {
     std::string debug_group_name = "/DEBUG";
     size_t debug_group = createGroup(file_, debug_group_name);
@@ -97,106 +122,6 @@ void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
   irun_++;
 }
 
-void HDF5Writer::WriteSensorDataInfo(int evt_number, unsigned int sensor_id,
-                                     unsigned int charge)
-{
-  sns_data_t snsData;
-  snsData.event_id = evt_number;
-  snsData.sensor_id = sensor_id;
-  snsData.charge = charge;
-  writeSnsData(&snsData, snsDataTable_, memtypeSnsData_, ismp_);
-
-  ismp_++;
-}
-
-void HDF5Writer::WriteSensorTofInfo(int evt_number, int sensor_id, float time,
-                                    unsigned int track_id)
-{
-  sns_tof_t snsTof;
-  snsTof.event_id = evt_number;
-  snsTof.sensor_id = sensor_id;
-  snsTof.time = time;
-  snsTof.track_id = track_id;
-  writeSnsTof(&snsTof, snsTofTable_, memtypeSnsTof_, ismp_tof_);
-
-  ismp_tof_++;
-}
-
-
-void HDF5Writer::WriteHitInfo(int evt_number, int particle_indx,
-                              float hit_position_x, float hit_position_y,
-                              float hit_position_z, float hit_time,
-                              float hit_energy, const char* label)
-{
-  hit_info_t trueInfo;
-  trueInfo.event_id = evt_number;
-  memset(trueInfo.label, 0, STRLEN);
-  trueInfo.x = hit_position_x;
-  trueInfo.y = hit_position_y;
-  trueInfo.z = hit_position_z;
-  trueInfo.time = hit_time;
-  trueInfo.energy = hit_energy;
-  strcpy(trueInfo.label, label);
-  trueInfo.particle_id = particle_indx;
-  writeHit(&trueInfo,  hitInfoTable_, memtypeHitInfo_, ihit_);
-
-  ihit_++;
-}
-
-void HDF5Writer::WriteParticleInfo(int evt_number, int particle_indx,
-                                   const char* particle_name, char primary,
-                                   int mother_id, float initial_vertex_x,
-                                   float initial_vertex_y,
-                                   float initial_vertex_z,
-                                   float initial_vertex_t,
-                                   float final_vertex_x,
-                                   float final_vertex_y, float final_vertex_z,
-                                   float final_vertex_t,
-                                   const char* initial_volume,
-                                   const char* final_volume, float momentum_x,
-                                   float momentum_y, float momentum_z,
-                                   float final_momentum_x,
-                                   float final_momentum_y,
-                                   float final_momentum_z, float kin_energy,
-                                   float length, const char* creator_proc,
-                                   const char* final_proc)
-{
-  particle_info_t trueInfo;
-  trueInfo.event_id = evt_number;
-  trueInfo.particle_id = particle_indx;
-  memset(trueInfo.particle_name, 0, STRLEN);
-  strcpy(trueInfo.particle_name, particle_name);
-  trueInfo.primary = primary;
-  trueInfo.mother_id = mother_id;
-  trueInfo.initial_x = initial_vertex_x;
-  trueInfo.initial_y = initial_vertex_y;
-  trueInfo.initial_z = initial_vertex_z;
-  trueInfo.initial_t = initial_vertex_t;
-  trueInfo.final_x = final_vertex_x;
-  trueInfo.final_y = final_vertex_y;
-  trueInfo.final_z = final_vertex_z;
-  trueInfo.final_t = final_vertex_t;
-  memset(trueInfo.initial_volume, 0, STRLEN);
-  strcpy(trueInfo.initial_volume, initial_volume);
-  memset(trueInfo.final_volume, 0, STRLEN);
-  strcpy(trueInfo.final_volume, final_volume);
-  trueInfo.initial_momentum_x = momentum_x;
-  trueInfo.initial_momentum_y = momentum_y;
-  trueInfo.initial_momentum_z = momentum_z;
-  trueInfo.final_momentum_x = final_momentum_x;
-  trueInfo.final_momentum_y = final_momentum_y;
-  trueInfo.final_momentum_z = final_momentum_z;
-  trueInfo.kin_energy = kin_energy;
-  trueInfo.length = length;
-  memset(trueInfo.creator_proc, 0, STRLEN);
-  strcpy(trueInfo.creator_proc, creator_proc);
-  memset(trueInfo.final_proc, 0, STRLEN);
-  strcpy(trueInfo.final_proc, final_proc);
-  writeParticle(&trueInfo,  particleInfoTable_, memtypeParticleInfo_, ipart_);
-
-  ipart_++;
-}
-
 void HDF5Writer::WriteSensorPosInfo(unsigned int sensor_id,
                                     const char* sensor_name, float x, float y,
                                     float z)
@@ -213,48 +138,51 @@ void HDF5Writer::WriteSensorPosInfo(unsigned int sensor_id,
   ipos_++;
 }
 
-void HDF5Writer::WriteStep(int evt_number,
-                           int particle_id, const char* particle_name,
-                           int step_id,
-                           const char* initial_volume,
-                           const char*   final_volume,
-                           const char*      proc_name,
-                           float initial_x, float initial_y, float initial_z,
-                           float   final_x, float   final_y, float   final_z)
+void HDF5Writer::WriteEvent(const EventBuffer& buffer)
+{
+  // One write per table, with all the rows of the event
+  WriteRows(buffer.GetSensorData(), snsDataTable_, memtypeSnsData_, ismp_);
+  WriteRows(buffer.GetSensorTof(), snsTofTable_, memtypeSnsTof_, ismp_tof_);
+  WriteRows(buffer.GetHits(), hitInfoTable_, memtypeHitInfo_, ihit_);
+  WriteRows(buffer.GetParticles(), particleInfoTable_, memtypeParticleInfo_,
+            ipart_);
+  WriteRows(buffer.GetSensorPos(), snsPosTable_, memtypeSnsPos_, ipos_);
+  WriteRows(buffer.GetSteps(), stepTable_, memtypeStep_, istep_);
+  WriteRows(buffer.GetChargeData(), chargeDataTable_, memtypeChargeData_,
+            icharge_);
+  WriteRows(buffer.GetProfile(), profileTable_, memtypeProfile_, iprof_);
+}
+
+void HDF5Writer::WriteLUTPointInfo(unsigned int point_id,
+                                   float x, float y, float z,
+                                   unsigned int n_events, double n_photons)
 {
-  step_info_t step;
-  step.event_id    = evt_number;
-  step.particle_id = particle_id;
-  memset(step.particle_name , 0,  STRLEN);
-  strcpy(step.particle_name ,  particle_name);
-  step.step_id    = step_id;
-  memset(step.initial_volume, 0, STRLEN);
-  strcpy(step.initial_volume, initial_volume);
-  memset(step.  final_volume, 0, STRLEN);
-  strcpy(step.  final_volume,   final_volume);
-  memset(step.     proc_name, 0, STRLEN);
-  strcpy(step.     proc_name,      proc_name);
-  step.initial_x   = initial_x;
-  step.initial_y   = initial_y;
-  step.initial_z   = initial_z;
-  step.  final_x   =   final_x;
-  step.  final_y   =   final_y;
-  step.  final_z   =   final_z;
-
-  writeStep(&step, stepTable_, memtypeStep_, istep_);
-
-  istep_++;
+  lut_point_t lutPoint;
+  lutPoint.point_id = point_id;
+  lutPoint.x = x;
+  lutPoint.y = y;
+  lutPoint.z = z;
+  lutPoint.n_events = n_events;
+  lutPoint.n_photons = n_photons;
+  writeLUTPoint(&lutPoint, lutPointTable_, memtypeLUTPoint_, ilutpt_);
+
+  ilutpt_++;
 }
 
-void HDF5Writer::WriteChargeDataInfo(int evt_number, unsigned int sensor_id,
-                                     unsigned int time_bin, unsigned int charge)
+void HDF5Writer::WriteLUTInfo(std::vector<lut_t>& rows)
 {
-  charge_data_t chargeData;
-  chargeData.event_id = evt_number;
-  chargeData.sensor_id = sensor_id;
-  chargeData.time_bin = time_bin;
-  chargeData.charge = charge;
-  writeChargeData(&chargeData, chargeDataTable_, memtypeChargeData_, icharge_);
-
-  icharge_++;
+  if (rows.empty()) return;
+
+  writeLUT(rows.data(), rows.size(), lutTable_, memtypeLUT_, ilut_);
+
+  ilut_ += rows.size();
+}
+
+void HDF5Writer::WriteSensitivityInfo(std::vector<sens_point_t>& rows)
+{
+  if (rows.empty()) return;
+
+  writeSensPoints(rows.data(), rows.size(), sensTable_, memtypeSens_, isens_);
+
+  isens_ += rows.size();
 }
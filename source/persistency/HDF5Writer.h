@@ -10,9 +10,11 @@
 #define HDF5WRITER_H
 
 #include "hdf5_functions.h"
+#include "EventBuffer.h"
 
 #include <hdf5.h>
 #include <iostream>
+#include <vector>
 
 class HDF5Writer
 {
@@ -24,44 +26,28 @@ public:
   ~HDF5Writer();
 
   //! open file
-  void Open(std::string filename, bool debug);
+  void Open(std::string filename, bool debug, bool lut=false,
+            bool sensitivity=false, bool profile=false);
 
   //! close file
   void Close();
 
   void WriteRunInfo(const char *param_key, const char *param_value);
-  void WriteSensorDataInfo(int evt_number, unsigned int sensor_id,
-                           unsigned int charge);
-  void WriteSensorTofInfo(int evt_number, int sensor_id, float time,
-                          unsigned int track_id);
-  void WriteHitInfo(int evt_number, int particle_indx, float hit_position_x,
-                    float hit_position_y, float hit_position_z, float hit_time,
-                    float hit_energy, const char *label);
-  void WriteParticleInfo(int evt_number, int particle_indx,
-                         const char *particle_name, char primary, int mother_id,
-                         float initial_vertex_x, float initial_vertex_y,
-                         float initial_vertex_z, float initial_vertex_t,
-                         float final_vertex_x, float final_vertex_y,
-                         float final_vertex_z, float final_vertex_t,
-                         const char *initial_volume, const char *final_volume,
-                         float momentum_x, float momentum_y, float momentum_z,
-                         float final_momentum_x, float final_momentum_y,
-                         float final_momentum_z, float kin_energy, float length,
-                         const char *creator_proc, const char *final_proc);
   void WriteSensorPosInfo(unsigned int sensor_id, const char *sensor_name,
                           float x, float y, float z);
-  void WriteStep(int evt_number,
-                 int particle_id, const char *particle_name,
-                 int step_id,
-                 const char *initial_volume,
-                 const char *final_volume,
-                 const char *proc_name,
-                 float initial_x, float initial_y, float initial_z,
-                 float final_x, float final_y, float final_z);
-  void WriteChargeDataInfo(int evt_number, unsigned int sensor_id,
-                           unsigned int time_bin, unsigned int charge);
+  /// Write all the rows of one event
+  void WriteEvent(const EventBuffer& buffer);
+  void WriteLUTPointInfo(unsigned int point_id, float x, float y, float z,
+                         unsigned int n_events, double n_photons);
+  void WriteLUTInfo(std::vector<lut_t>& rows);
+  void WriteSensitivityInfo(std::vector<sens_point_t>& rows);
 
 private:
+  /// Append rows at the end of a table, updating its counter
+  template <typename T>
+  void WriteRows(const std::vector<T>& rows, size_t table, size_t memtype,
+                 size_t& counter);
+
   size_t file_; ///< HDF5 file
 
   bool isOpen_;
@@ -78,6 +64,10 @@ private:
   size_t snsPosTable_;
   size_t stepTable_;
   size_t chargeDataTable_;
+  size_t lutPointTable_;
+  size_t lutTable_;
+  size_t sensTable_;
+  size_t profileTable_;
 
   size_t memtypeRun_;
   size_t memtypeSnsData_;
@@ -87,6 +77,10 @@ private:
   size_t memtypeSnsPos_;
   size_t memtypeStep_;
   size_t memtypeChargeData_;
+  size_t memtypeLUTPoint_;
+  size_t memtypeLUT_;
+  size_t memtypeSens_;
+  size_t memtypeProfile_;
 
   size_t irun_;     ///< counter for configuration parameters
   size_t ismp_;     ///< counter for total charge
@@ -96,6 +90,20 @@ private:
   size_t ipos_;     ///< counter for sensor positions
   size_t istep_;    ///< counter for steps
   size_t icharge_;  ///< counter for charge
+  size_t ilutpt_;   ///< counter for light-response table points
+  size_t ilut_;     ///< counter for light-response table entries
+  size_t isens_;    ///< counter for sensitivity map points
+  size_t iprof_;    ///< counter for profile entries
 };
 
+template <typename T>
+inline void HDF5Writer::WriteRows(const std::vector<T>& rows, size_t table,
+                                  size_t memtype, size_t& counter)
+{
+  if (rows.empty()) return;
+
+  writeRows(rows.data(), rows.size(), table, memtype, counter);
+  counter += rows.size();
+}
+
 #endif
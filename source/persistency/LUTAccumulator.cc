@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// petalosim | LUTAccumulator.cc
+//
+// This class accumulates in memory the response of each sensor to the
+// light generated at a set of points, to build a light-response table.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "LUTAccumulator.h"
+
+
+LUTAccumulator::LUTAccumulator()
+{
+}
+
+
+
+LUTAccumulator::~LUTAccumulator()
+{
+}
+
+
+
+G4int LUTAccumulator::FindPoint(const G4ThreeVector& pos)
+{
+  // Points are generated at the exact same coordinates for every event,
+  // so they can be used as a key without any tolerance
+  auto key = std::make_tuple(pos.x(), pos.y(), pos.z());
+  auto it = point_ids_.find(key);
+  if (it != point_ids_.end())
+    return it->second;
+
+  G4int id = points_.size();
+  point_ids_[key] = id;
+  points_.push_back({pos, 0, 0.});
+  entries_.push_back(std::map<G4int, Entry>());
+
+  return id;
+}
+
+
+
+void LUTAccumulator::AddEvent(G4int point_id, G4double n_photons)
+{
+  points_[point_id].n_events++;
+  points_[point_id].n_photons += n_photons;
+}
+
+
+
+void LUTAccumulator::AddPhotons(G4int point_id, G4int sensor_id,
+                                G4double time, G4int n)
+{
+  Entry& e = entries_[point_id][sensor_id];
+  e.counts += n;
+  e.sum_t  += n * time;
+  e.sum_t2 += n * time * time;
+}
+
+
+
+void LUTAccumulator::Clear()
+{
+  point_ids_.clear();
+  points_.clear();
+  entries_.clear();
+}
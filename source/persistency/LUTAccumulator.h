@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// petalosim | LUTAccumulator.h
+//
+// This class accumulates in memory the response of each sensor to the
+// light generated at a set of points, to build a light-response table.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef LUT_ACCUMULATOR_H
+#define LUT_ACCUMULATOR_H
+
+#include <G4ThreeVector.hh>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+class LUTAccumulator
+{
+public:
+  /// Accumulated response of one sensor to one point
+  struct Entry
+  {
+    G4double counts;  ///< detected photons
+    G4double sum_t;   ///< sum of the arrival times of the detected photons
+    G4double sum_t2;  ///< sum of the squared arrival times
+  };
+
+  /// Photons generated at one point
+  struct Point
+  {
+    G4ThreeVector pos;
+    G4int n_events;
+    G4double n_photons;
+  };
+
+  LUTAccumulator();
+  ~LUTAccumulator();
+
+  /// Return the index of the point at the given position,
+  /// registering it if it has not been seen before
+  G4int FindPoint(const G4ThreeVector& pos);
+  /// Add the number of photons generated in one event at a point
+  void AddEvent(G4int point_id, G4double n_photons);
+  /// Add n photons detected by a sensor at a given time
+  void AddPhotons(G4int point_id, G4int sensor_id, G4double time, G4int n);
+
+  const std::vector<Point>& GetPoints() const;
+  const std::map<G4int, Entry>& GetEntries(G4int point_id) const;
+
+  void Clear();
+
+private:
+  std::map<std::tuple<G4double, G4double, G4double>, G4int> point_ids_;
+  std::vector<Point> points_;
+  std::vector<std::map<G4int, Entry>> entries_; ///< indexed by point
+};
+
+inline const std::vector<LUTAccumulator::Point>&
+LUTAccumulator::GetPoints() const { return points_; }
+
+inline const std::map<G4int, LUTAccumulator::Entry>&
+LUTAccumulator::GetEntries(G4int point_id) const { return entries_[point_id]; }
+
+#endif
@@ -9,10 +9,13 @@
 
 #include "PetaloPersistencyManager.h"
 #include "HDF5Writer.h"
+#include "AsyncEventWriter.h"
 #include "ToFSD.h"
 #include "ChargeSD.h"
 #include "PetSaveAllSteppingAction.h"
 #include "PetIonizationSD.h"
+#include "FullRingInfinity.h"
+#include "TrackProfile.h"
 
 #include "nexus/Trajectory.h"
 #include "nexus/TrajectoryMap.h"
@@ -29,17 +32,23 @@
 #include <G4RunManager.hh>
 #include <G4Run.hh>
 #include <G4OpticalPhoton.hh>
+#include <G4PrimaryVertex.hh>
 
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
 
 using namespace nexus;
 using namespace CLHEP;
 
 REGISTER_CLASS(PetaloPersistencyManager, PersistencyManagerBase)
 
+
 PetaloPersistencyManager::PetaloPersistencyManager():
   PersistencyManagerBase(), msg_(0), output_file_("petalo_out"),
   store_evt_(true), store_steps_(false),
@@ -47,7 +56,9 @@ PetaloPersistencyManager::PetaloPersistencyManager():
   efield_(0), saved_evts_(0), interacting_evts_(0),
   nevt_(0), start_id_(0), first_evt_(true),
   thr_charge_(0), tof_time_(50.*nanosecond), sns_only_(false),
-  save_tot_charge_(true), sipm_cells_(false), h5writer_(0)
+  save_tot_charge_(true), sipm_cells_(false), lut_(false),
+  sensitivity_(false), sens_geom_(0), async_(false), async_queue_size_(64),
+  async_writer_(0), evt_buffer_(0), profile_(0), h5writer_(0)
 {
   msg_ = new G4GenericMessenger(this, "/petalosim/persistency/");
   msg_->DeclareProperty("output_file", output_file_, "Path of output file.");
@@ -61,6 +72,14 @@ PetaloPersistencyManager::PetaloPersistencyManager():
                         "If true, total charge is saved.");
   msg_->DeclareProperty("sipm_cells", sipm_cells_,
                         "True if each individual cell of SiPMs is simulated.");
+  msg_->DeclareProperty("lut", lut_,
+                        "If true, only the light-response table is saved.");
+  msg_->DeclareProperty("sensitivity", sensitivity_,
+                        "If true, only the sensitivity map is saved.");
+  msg_->DeclareProperty("async_writer", async_,
+                        "If true, events are written by a separate thread.");
+  msg_->DeclareProperty("async_queue_size", async_queue_size_,
+                        "Events per thread waiting to be written.");
 
   G4GenericMessenger::Command& time_cmd =
     msg_->DeclareProperty("tof_time", tof_time_,
@@ -80,6 +99,7 @@ PetaloPersistencyManager::PetaloPersistencyManager():
 PetaloPersistencyManager::~PetaloPersistencyManager()
 {
   delete msg_;
+  delete async_writer_;
   delete h5writer_;
 }
 
@@ -89,7 +109,12 @@ void PetaloPersistencyManager::OpenFile()
 {
   h5writer_ = new HDF5Writer();
   G4String hdf5file = output_file_ + ".h5";
-  h5writer_->Open(hdf5file, store_steps_);
+  h5writer_->Open(hdf5file, store_steps_, lut_, sensitivity_,
+                  profile_ && profile_->GetSaveTable());
+
+  // In LUT and sensitivity modes no events are written
+  if (async_ && !lut_ && !sensitivity_)
+    async_writer_ = new AsyncEventWriter(h5writer_, async_queue_size_);
   return;
 }
 
@@ -97,6 +122,9 @@ void PetaloPersistencyManager::OpenFile()
 
 void PetaloPersistencyManager::CloseFile()
 {
+  // Pending events are written before closing the file
+  delete async_writer_;
+  async_writer_ = 0;
   h5writer_->Close();
   return;
 }
@@ -109,6 +137,25 @@ G4bool PetaloPersistencyManager::Store(const G4Event* event)
     interacting_evts_++;
   }
 
+  if (profile_)
+    profile_->EndEvent(event->GetHCofThisEvent());
+
+  if (lut_) {
+    // Events are only accumulated in memory; the table is saved
+    // at the end of the run
+    AccumulateLUT(event);
+    TrajectoryMap::Clear();
+    return false;
+  }
+
+  if (sensitivity_) {
+    // Only the number of generated and selected events per point
+    // is kept; the map is saved at the end of the run
+    AccumulateSensitivity(event);
+    TrajectoryMap::Clear();
+    return false;
+  }
+
   if (!store_evt_) {
     TrajectoryMap::Clear();
     if (store_steps_) {
@@ -127,6 +174,10 @@ G4bool PetaloPersistencyManager::Store(const G4Event* event)
     nevt_ = start_id_;
   }
 
+  // The rows of the event are collected and then written together,
+  // either here or by the writer thread
+  evt_buffer_ = async_writer_ ? async_writer_->GetBuffer() : &sync_buffer_;
+
   if (store_steps_)
     StoreSteps();
 
@@ -136,6 +187,17 @@ G4bool PetaloPersistencyManager::Store(const G4Event* event)
 
   StoreHits(event->GetHCofThisEvent());
 
+  if (profile_ && profile_->GetSaveTable())
+    StoreProfile();
+
+  if (async_writer_) {
+    async_writer_->Push(evt_buffer_);
+  } else {
+    h5writer_->WriteEvent(sync_buffer_);
+    sync_buffer_.Clear();
+  }
+  evt_buffer_ = 0;
+
   nevt_++;
 
   TrajectoryMap::Clear();
@@ -202,19 +264,19 @@ void PetaloPersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
       mother_id = trj->GetParentID();
     }
 
-    h5writer_->WriteParticleInfo(nevt_, trackid, trj->GetParticleName().c_str(),
-				 primary, mother_id,
-				 (float)ini_xyz.x(), (float)ini_xyz.y(),
-                                 (float)ini_xyz.z(), (float)ini_t,
-				 (float)final_xyz.x(), (float)final_xyz.y(),
-                                 (float)final_xyz.z(), (float)final_t,
-				 ini_volume.c_str(), final_volume.c_str(),
-				 (float)ini_mom.x(), (float)ini_mom.y(),
-                                 (float)ini_mom.z(), (float)final_mom.x(),
-                                 (float)final_mom.y(), (float)final_mom.z(),
-				 kin_energy, length,
-                                 trj->GetCreatorProcess().c_str(),
-				 trj->GetFinalProcess().c_str());
+    evt_buffer_->AddParticle(nevt_, trackid, trj->GetParticleName().c_str(),
+                             primary, mother_id,
+                             (float)ini_xyz.x(), (float)ini_xyz.y(),
+                             (float)ini_xyz.z(), (float)ini_t,
+                             (float)final_xyz.x(), (float)final_xyz.y(),
+                             (float)final_xyz.z(), (float)final_t,
+                             ini_volume.c_str(), final_volume.c_str(),
+                             (float)ini_mom.x(), (float)ini_mom.y(),
+                             (float)ini_mom.z(), (float)final_mom.x(),
+                             (float)final_mom.y(), (float)final_mom.z(),
+                             kin_energy, length,
+                             trj->GetCreatorProcess().c_str(),
+                             trj->GetFinalProcess().c_str());
 
   }
 }
@@ -276,10 +338,10 @@ void PetaloPersistencyManager::StoreIonizationHits(G4VHitsCollection* hc)
      G4int trackid = hit->GetTrackID();
      G4ThreeVector hit_pos = hit->GetPosition();
 
-     h5writer_->WriteHitInfo(nevt_, trackid,
-			     hit_pos[0], hit_pos[1], hit_pos[2],
-			     hit->GetTime(), hit->GetEnergyDeposit(),
-			     sdname.c_str());
+     evt_buffer_->AddHit(nevt_, trackid,
+                         hit_pos[0], hit_pos[1], hit_pos[2],
+                         hit->GetTime(), hit->GetEnergyDeposit(),
+                         sdname.c_str());
    }
 
  }
@@ -303,15 +365,15 @@ void PetaloPersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
       std::string sdname = hits->GetSDname();
       G4ThreeVector xyz = hit->GetPosition();
       if (save_tot_charge_ == true) {
-        h5writer_->WriteSensorDataInfo(nevt_, (unsigned int)s_id,
-                                       (unsigned int)charge);
+        evt_buffer_->AddSensorData(nevt_, (unsigned int)s_id,
+                                   (unsigned int)charge);
       }
       std::vector<G4int>::iterator pos_it =
         std::find(sns_posvec_.begin(), sns_posvec_.end(), s_id);
       if (pos_it == sns_posvec_.end()) {
-        h5writer_->WriteSensorPosInfo((unsigned int)s_id, sdname.c_str(),
-                                      (float)xyz.x(), (float)xyz.y(),
-                                      (float)xyz.z());
+        evt_buffer_->AddSensorPos((unsigned int)s_id, sdname.c_str(),
+                                  (float)xyz.x(), (float)xyz.y(),
+                                  (float)xyz.z());
         sns_posvec_.push_back(s_id);
       }
       // Save also individual photons
@@ -319,14 +381,14 @@ void PetaloPersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
       std::map<G4double, G4int>::const_iterator it;
       for (it = phot.begin(); it != phot.end(); ++it) {
         if (sipm_cells_) {
-          h5writer_->WriteSensorTofInfo(nevt_, (unsigned int)s_id,
-                                        (float)it->first,
-                                        (unsigned int)it->second);
+          evt_buffer_->AddSensorTof(nevt_, (unsigned int)s_id,
+                                    (float)it->first,
+                                    (unsigned int)it->second);
         } else {
           if (it->first <= tof_time_){
-            h5writer_->WriteSensorTofInfo(nevt_, (unsigned int)s_id,
-                                          (float)it->first,
-                                          (unsigned int)it->second);
+            evt_buffer_->AddSensorTof(nevt_, (unsigned int)s_id,
+                                      (float)it->first,
+                                      (unsigned int)it->second);
           } else {
             break;
           }
@@ -358,8 +420,8 @@ void PetaloPersistencyManager::StoreChargeHits(G4VHitsCollection* hc)
     for (it = wvfm.begin(); it != wvfm.end(); ++it) {
       unsigned int time_bin = (unsigned int)((*it).first/wire_bin_size_+0.5);
       unsigned int charge   = (unsigned int)((*it).second+0.5);
-      h5writer_->WriteChargeDataInfo(nevt_, (unsigned int)hit->GetSensorID(),
-                                     time_bin, charge);
+      evt_buffer_->AddChargeData(nevt_, (unsigned int)hit->GetSensorID(),
+                                 time_bin, charge);
     }
 
 
@@ -369,9 +431,9 @@ void PetaloPersistencyManager::StoreChargeHits(G4VHitsCollection* hc)
     if (pos_it == charge_posvec_.end()) {
       std::string sdname = hits->GetSDname();
       G4ThreeVector xyz  = hit->GetPosition();
-      h5writer_->WriteSensorPosInfo((unsigned int)hit->GetSensorID(),
-                                    sdname.c_str(), (float)xyz.x(),
-                                    (float)xyz.y(), (float)xyz.z());
+      evt_buffer_->AddSensorPos((unsigned int)hit->GetSensorID(),
+                                sdname.c_str(), (float)xyz.x(),
+                                (float)xyz.y(), (float)xyz.z());
       charge_posvec_.push_back(hit->GetSensorID());
     }
   }
@@ -395,7 +457,7 @@ void PetaloPersistencyManager::StoreSteps()
     G4String                   particle_name = key.second;
 
     for (size_t step_id=0; step_id < it->second.size(); ++step_id) {
-      h5writer_->WriteStep(nevt_, track_id, particle_name, step_id,
+      evt_buffer_->AddStep(nevt_, track_id, particle_name, step_id,
                            initial_volumes[key][step_id],
                            final_volumes[key][step_id],
                            proc_names[key][step_id],
@@ -410,8 +472,233 @@ void PetaloPersistencyManager::StoreSteps()
   sa->Reset();
 }
 
+void PetaloPersistencyManager::AccumulateLUT(const G4Event* event)
+{
+  if (event->GetNumberOfPrimaryVertex() == 0) return;
+
+  G4int point_id =
+    lut_acc_.FindPoint(event->GetPrimaryVertex()->GetPosition());
+
+  G4int n_photons = 0;
+  for (G4int i=0; i<event->GetNumberOfPrimaryVertex(); i++)
+    n_photons += event->GetPrimaryVertex(i)->GetNumberOfParticle();
+  lut_acc_.AddEvent(point_id, n_photons);
+
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if (!hce) return;
+
+  G4SDManager* sdmgr = G4SDManager::GetSDMpointer();
+  G4HCtable* hct = sdmgr->GetHCtable();
+
+  for (int i=0; i<hct->entries(); i++) {
+
+    G4String hcname = hct->GetHCname(i);
+    if (hcname != ToFSD::GetCollectionUniqueName()) continue;
+
+    G4String sdname = hct->GetSDname(i);
+    int hcid = sdmgr->GetCollectionID(sdname+"/"+hcname);
+    PetSensorHitsCollection* hits =
+      dynamic_cast<PetSensorHitsCollection*>(hce->GetHC(hcid));
+    if (!hits) continue;
+
+    for (size_t j=0; j<hits->entries(); j++) {
+
+      PetSensorHit* hit = dynamic_cast<PetSensorHit*>(hits->GetHit(j));
+      if (!hit) continue;
+
+      G4int s_id = hit->GetSnsID();
+
+      std::vector<G4int>::iterator pos_it =
+        std::find(sns_posvec_.begin(), sns_posvec_.end(), s_id);
+      if (pos_it == sns_posvec_.end()) {
+        G4ThreeVector xyz = hit->GetPosition();
+        h5writer_->WriteSensorPosInfo((unsigned int)s_id, sdname.c_str(),
+                                      (float)xyz.x(), (float)xyz.y(),
+                                      (float)xyz.z());
+        sns_posvec_.push_back(s_id);
+      }
+
+      const std::map<G4double, G4int>& phot = hit->GetPhotonMap();
+      std::map<G4double, G4int>::const_iterator it;
+      for (it = phot.begin(); it != phot.end(); ++it) {
+        lut_acc_.AddPhotons(point_id, s_id, it->first, it->second);
+      }
+    }
+  }
+}
+
+
+
+void PetaloPersistencyManager::StoreLUT()
+{
+  const std::vector<LUTAccumulator::Point>& points = lut_acc_.GetPoints();
+
+  std::vector<lut_t> rows;
+  for (size_t i=0; i<points.size(); i++) {
+    const LUTAccumulator::Point& pt = points[i];
+    h5writer_->WriteLUTPointInfo((unsigned int)i, (float)pt.pos.x(),
+                                 (float)pt.pos.y(), (float)pt.pos.z(),
+                                 (unsigned int)pt.n_events, pt.n_photons);
+
+    // One row per sensor which has detected light from this point
+    rows.clear();
+    const std::map<G4int, LUTAccumulator::Entry>& entries =
+      lut_acc_.GetEntries(i);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      const LUTAccumulator::Entry& e = it->second;
+      G4double mean = e.sum_t / e.counts;
+      G4double var  = std::max(e.sum_t2 / e.counts - mean * mean, 0.);
+
+      lut_t row;
+      row.point_id    = (unsigned int)i;
+      row.sensor_id   = (unsigned int)it->first;
+      row.probability = pt.n_photons > 0 ? e.counts / pt.n_photons : 0.;
+      row.counts      = e.counts;
+      row.mean_time   = mean;
+      row.rms_time    = std::sqrt(var);
+      rows.push_back(row);
+    }
+    h5writer_->WriteLUTInfo(rows);
+  }
+
+  G4cout << "Light-response table saved with " << points.size()
+         << " points." << G4endl;
+  lut_acc_.Clear();
+}
+
+void PetaloPersistencyManager::AccumulateSensitivity(const G4Event* event)
+{
+  // Aborted events, such as those requested beyond the slice of points
+  // of the job, belong to no point and are not counted as generated
+  if (event->IsAborted() || event->GetNumberOfPrimaryVertex() == 0) return;
+
+  if (!sens_geom_) {
+    DetectorConstruction* detconst = (DetectorConstruction*)
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction();
+    sens_geom_ = dynamic_cast<FullRingInfinity*>(detconst->GetGeometry());
+    if (!sens_geom_)
+      G4Exception("[PetaloPersistencyManager]", "AccumulateSensitivity()",
+                  FatalException,
+                  "The sensitivity map is only available for FullRingInfinity.");
+  }
+
+  G4int point_id = sens_geom_->GetSensitivityPoint();
+  if (point_id < 0) return;
+
+  // The selection is the one of the event action (energy window)
+  G4bool selected = store_evt_;
+
+  // A coincidence requires both gammas of a back-to-back pair to
+  // deposit energy. The primaries of pair k have track IDs 2k+1 and 2k+2.
+  G4bool coincidence = false;
+  G4TrajectoryContainer* tc = event->GetTrajectoryContainer();
+  if (selected && tc) {
+    std::map<G4int, G4int> parents;
+    for (size_t i=0; i<tc->entries(); ++i) {
+      Trajectory* trj = dynamic_cast<Trajectory*>((*tc)[i]);
+      if (!trj) continue;
+      parents[trj->GetTrackID()] = trj->GetParentID();
+    }
+
+    std::set<G4int> depositing;
+    for (size_t i=0; i<tc->entries(); ++i) {
+      Trajectory* trj = dynamic_cast<Trajectory*>((*tc)[i]);
+      if (!trj || trj->GetEnergyDeposit() <= 0.) continue;
+
+      G4int id = trj->GetTrackID();
+      auto it = parents.find(id);
+      while (it != parents.end() && it->second != 0) {
+        id = it->second;
+        it = parents.find(id);
+      }
+      depositing.insert(id);
+    }
+
+    for (auto it = depositing.begin(); it != depositing.end(); ++it) {
+      if (*it % 2 == 1 && depositing.count(*it + 1)) {
+        coincidence = true;
+        break;
+      }
+    }
+  }
+
+  sens_acc_.AddEvent(point_id, event->GetPrimaryVertex()->GetPosition(),
+                     selected, coincidence);
+}
+
+
+
+void PetaloPersistencyManager::StoreSensitivity()
+{
+  const std::map<G4int, SensitivityAccumulator::Point>& points =
+    sens_acc_.GetPoints();
+
+  std::vector<sens_point_t> rows;
+  rows.reserve(points.size());
+  for (auto it = points.begin(); it != points.end(); ++it) {
+    const SensitivityAccumulator::Point& pt = it->second;
+    sens_point_t row;
+    row.point_id       = (unsigned int)it->first;
+    row.x              = (float)pt.pos.x();
+    row.y              = (float)pt.pos.y();
+    row.z              = (float)pt.pos.z();
+    row.n_generated    = (unsigned int)pt.n_generated;
+    row.n_selected     = (unsigned int)pt.n_selected;
+    row.n_coincidences = (unsigned int)pt.n_coincidences;
+    rows.push_back(row);
+  }
+  h5writer_->WriteSensitivityInfo(rows);
+
+  G4cout << "Sensitivity map saved with " << points.size()
+         << " points." << G4endl;
+  sens_acc_.Clear();
+}
+
+
+
+void PetaloPersistencyManager::StoreProfile()
+{
+  for (G4int i=0; i<TrackProfile::kNSpecies; i++) {
+    if (profile_->GetTracks(i) == 0) continue;
+    evt_buffer_->AddProfile(nevt_, TrackProfile::GetSpeciesName(i),
+                            profile_->GetTracks(i), profile_->GetSteps(i),
+                            profile_->GetWallTime(i));
+  }
+}
+
+
+
+void PetaloPersistencyManager::StoreProfileSummary()
+{
+  profile_->PrintSummary();
+
+  G4String key = "profile_peak_rss";
+  h5writer_->WriteRunInfo(key,
+    (std::to_string(profile_->GetPeakRSS())+" kB").c_str());
+  for (auto& hc: profile_->GetPeakHits()) {
+    key = "profile_peak_hits_" + hc.first;
+    h5writer_->WriteRunInfo(key, std::to_string(hc.second).c_str());
+  }
+
+  profile_->ResetRun();
+}
+
+
+
 G4bool PetaloPersistencyManager::Store(const G4Run*)
 {
+  // The events of the run must be in the file before the run information
+  if (async_writer_)
+    async_writer_->Flush();
+
+  if (lut_)
+    StoreLUT();
+
+  if (sensitivity_)
+    StoreSensitivity();
+
+  if (profile_)
+    StoreProfileSummary();
 
   // Store the number of events to be processed
   NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
@@ -431,6 +718,11 @@ G4bool PetaloPersistencyManager::Store(const G4Run*)
   key = "electric_field";
   h5writer_->WriteRunInfo(key, (std::to_string(efield_)+" V/cm").c_str());
 
+  for (unsigned long i=0; i<run_info_.size(); i++) {
+    h5writer_->WriteRunInfo(run_info_[i].first.c_str(),
+                            run_info_[i].second.c_str());
+  }
+
   SaveConfigurationInfo(init_macro_);
   for (unsigned long i=0; i<macros_.size(); i++) {
     SaveConfigurationInfo(macros_[i]);
@@ -10,9 +10,14 @@
 #ifndef P_PERSISTENCY_MANAGER_H
 #define P_PERSISTENCY_MANAGER_H
 
+#include "LUTAccumulator.h"
+#include "SensitivityAccumulator.h"
+#include "EventBuffer.h"
+
 #include "nexus/PersistencyManagerBase.h"
 #include <G4VPersistencyManager.hh>
 #include <vector>
+#include <utility>
 
 class G4GenericMessenger;
 class G4TrajectoryContainer;
@@ -20,6 +25,9 @@ class G4HCofThisEvent;
 class G4VHitsCollection;
 
 class HDF5Writer;
+class AsyncEventWriter;
+class FullRingInfinity;
+class TrackProfile;
 
 class PetaloPersistencyManager : public PersistencyManagerBase
 {
@@ -38,6 +46,16 @@ public:
   void SaveNumbOfInteractingEvents(G4bool);
 
   void SetElectricField(G4double);
+  G4double GetElectricField() const;
+
+  /// Starting event ID of this job
+  G4int GetStartID() const;
+
+  /// Set the tracking profile saved with each event
+  void SetTrackProfile(TrackProfile*);
+
+  /// Add a key-value pair to the configuration table of the file
+  void AddRunInfo(const G4String& key, const G4String& value);
 
   ///
   virtual G4bool Store(const G4Event *);
@@ -59,6 +77,12 @@ private:
   void StoreSensorHits(G4VHitsCollection *);
   void StoreChargeHits(G4VHitsCollection *);
   void StoreSteps();
+  void AccumulateLUT(const G4Event *);
+  void StoreLUT();
+  void AccumulateSensitivity(const G4Event *);
+  void StoreSensitivity();
+  void StoreProfile();
+  void StoreProfileSummary();
 
   void SaveConfigurationInfo(G4String history);
 
@@ -67,6 +91,8 @@ private:
   G4String output_file_; ///< Output file name
 
   std::vector<G4String> secondary_macros_;
+  /// Extra configuration information, written at the end of the run
+  std::vector<std::pair<G4String, G4String>> run_info_;
 
   G4bool store_evt_;       ///< Should we store the current event?
   G4bool store_steps_;     ///< Should we store the steps for the current event?
@@ -91,6 +117,17 @@ private:
   G4bool sns_only_;
   G4bool save_tot_charge_;
   G4bool sipm_cells_;
+  G4bool lut_;               ///< Only the light-response table is saved
+  LUTAccumulator lut_acc_;   ///< In-memory light-response table
+  G4bool sensitivity_;       ///< Only the sensitivity map is saved
+  SensitivityAccumulator sens_acc_; ///< In-memory sensitivity map
+  FullRingInfinity* sens_geom_;     ///< Geometry generating the map points
+  G4bool async_;                    ///< Events are written by a separate thread
+  G4int async_queue_size_;          ///< Events per thread waiting to be written
+  AsyncEventWriter* async_writer_;  ///< Writer thread
+  EventBuffer* evt_buffer_;         ///< Rows of the event being stored
+  EventBuffer sync_buffer_;         ///< Buffer used without writer thread
+  TrackProfile* profile_;           ///< Tracking profile, if any
   HDF5Writer *h5writer_; ///< Event writer to hdf5 file
 
   G4double bin_size_, tof_bin_size_, wire_bin_size_;
@@ -118,6 +155,23 @@ inline void PetaloPersistencyManager::SetElectricField(G4double efield)
 {
   efield_ = efield;
 }
+inline void PetaloPersistencyManager::AddRunInfo(const G4String& key,
+                                                 const G4String& value)
+{
+  run_info_.push_back(std::make_pair(key, value));
+}
+inline G4double PetaloPersistencyManager::GetElectricField() const
+{
+  return efield_;
+}
+inline G4int PetaloPersistencyManager::GetStartID() const
+{
+  return start_id_;
+}
+inline void PetaloPersistencyManager::SetTrackProfile(TrackProfile* profile)
+{
+  profile_ = profile;
+}
 inline G4bool PetaloPersistencyManager::Store(const G4VPhysicalVolume *)
 {
   return false;
@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// petalosim | SPSCQueue.h
+//
+// Bounded lock-free queue with a single producer thread and a single
+// consumer thread. Push and Pop never block: they return false when the
+// queue is full or empty, respectively.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+template <typename T>
+class SPSCQueue
+{
+public:
+  /// Constructor of a queue which can hold up to capacity elements
+  SPSCQueue(size_t capacity);
+
+  /// Called only by the producer. Returns false if the queue is full.
+  bool Push(const T& value);
+  /// Called only by the consumer. Returns false if the queue is empty.
+  bool Pop(T& value);
+
+  bool IsEmpty() const;
+
+private:
+  std::vector<T> buffer_; ///< one slot more than the capacity
+
+  // Kept in different cache lines, since each one is written
+  // by a different thread
+  alignas(64) std::atomic<size_t> head_; ///< next slot to be read
+  alignas(64) std::atomic<size_t> tail_; ///< next slot to be written
+};
+
+template <typename T>
+SPSCQueue<T>::SPSCQueue(size_t capacity):
+  buffer_(capacity + 1), head_(0), tail_(0)
+{
+}
+
+template <typename T>
+bool SPSCQueue<T>::Push(const T& value)
+{
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t next = (tail + 1) % buffer_.size();
+  if (next == head_.load(std::memory_order_acquire))
+    return false;
+
+  buffer_[tail] = value;
+  tail_.store(next, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool SPSCQueue<T>::Pop(T& value)
+{
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tail_.load(std::memory_order_acquire))
+    return false;
+
+  value = buffer_[head];
+  head_.store((head + 1) % buffer_.size(), std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool SPSCQueue<T>::IsEmpty() const
+{
+  return head_.load(std::memory_order_acquire) ==
+    tail_.load(std::memory_order_acquire);
+}
+
+#endif
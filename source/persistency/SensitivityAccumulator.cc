@@ -0,0 +1,46 @@
+// ----------------------------------------------------------------------------
+// petalosim | SensitivityAccumulator.cc
+//
+// This class counts in memory, for each point of a sensitivity map,
+// the events generated and the events selected by the energy cut.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SensitivityAccumulator.h"
+
+
+SensitivityAccumulator::SensitivityAccumulator()
+{
+}
+
+
+
+SensitivityAccumulator::~SensitivityAccumulator()
+{
+}
+
+
+
+void SensitivityAccumulator::AddEvent(G4int point_id, const G4ThreeVector& pos,
+                                      G4bool selected, G4bool coincidence)
+{
+  auto it = points_.find(point_id);
+  if (it == points_.end())
+    it = points_.insert(std::make_pair(point_id, Point{pos, 0, 0, 0})).first;
+
+  Point& pt = it->second;
+  pt.n_generated++;
+  if (selected) {
+    pt.n_selected++;
+    if (coincidence)
+      pt.n_coincidences++;
+  }
+}
+
+
+
+void SensitivityAccumulator::Clear()
+{
+  points_.clear();
+}
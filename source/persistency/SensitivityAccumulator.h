@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// petalosim | SensitivityAccumulator.h
+//
+// This class counts in memory, for each point of a sensitivity map,
+// the events generated and the events selected by the energy cut.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SENSITIVITY_ACCUMULATOR_H
+#define SENSITIVITY_ACCUMULATOR_H
+
+#include <G4ThreeVector.hh>
+
+#include <map>
+
+class SensitivityAccumulator
+{
+public:
+  /// Events counted at one point of the map
+  struct Point
+  {
+    G4ThreeVector pos;
+    G4int n_generated;    ///< events generated at the point
+    G4int n_selected;     ///< events passing the energy cut
+    G4int n_coincidences; ///< selected events with both gammas of a pair
+                          ///< depositing energy in the detector
+  };
+
+  SensitivityAccumulator();
+  ~SensitivityAccumulator();
+
+  /// Count one event generated at a point
+  void AddEvent(G4int point_id, const G4ThreeVector& pos,
+                G4bool selected, G4bool coincidence);
+
+  /// Points ordered by their index in the map
+  const std::map<G4int, Point>& GetPoints() const;
+
+  void Clear();
+
+private:
+  std::map<G4int, Point> points_;
+};
+
+inline const std::map<G4int, SensitivityAccumulator::Point>&
+SensitivityAccumulator::GetPoints() const { return points_; }
+
+#endif
@@ -213,6 +213,78 @@ hsize_t createChargeDataType()
   return memtype;
 }
 
+hsize_t createLUTPointType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (lut_point_t));
+  H5Tinsert (memtype, "point_id", HOFFSET (lut_point_t, point_id),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "x", HOFFSET (lut_point_t, x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "y", HOFFSET (lut_point_t, y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "z", HOFFSET (lut_point_t, z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "n_events", HOFFSET (lut_point_t, n_events),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "n_photons", HOFFSET (lut_point_t, n_photons),
+             H5T_NATIVE_DOUBLE);
+  return memtype;
+}
+
+hsize_t createLUTType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (lut_t));
+  H5Tinsert (memtype, "point_id", HOFFSET (lut_t, point_id),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "sensor_id", HOFFSET (lut_t, sensor_id),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "probability", HOFFSET (lut_t, probability),
+             H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "counts", HOFFSET (lut_t, counts), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "mean_time", HOFFSET (lut_t, mean_time),
+             H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "rms_time", HOFFSET (lut_t, rms_time),
+             H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
+hsize_t createSensPointType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (sens_point_t));
+  H5Tinsert (memtype, "point_id", HOFFSET (sens_point_t, point_id),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "x", HOFFSET (sens_point_t, x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "y", HOFFSET (sens_point_t, y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "z", HOFFSET (sens_point_t, z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "n_generated", HOFFSET (sens_point_t, n_generated),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "n_selected", HOFFSET (sens_point_t, n_selected),
+             H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "n_coincidences",
+             HOFFSET (sens_point_t, n_coincidences), H5T_NATIVE_UINT);
+  return memtype;
+}
+
+hsize_t createProfileType()
+{
+  hid_t strtype = H5Tcopy(H5T_C_S1);
+  H5Tset_size (strtype, STRLEN);
+
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (profile_t));
+  H5Tinsert (memtype, "event_id", HOFFSET (profile_t, event_id),
+             H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_name", HOFFSET (profile_t, particle_name),
+             strtype);
+  H5Tinsert (memtype, "n_tracks", HOFFSET (profile_t, n_tracks),
+             H5T_NATIVE_UINT64);
+  H5Tinsert (memtype, "n_steps", HOFFSET (profile_t, n_steps),
+             H5T_NATIVE_UINT64);
+  H5Tinsert (memtype, "wall_time", HOFFSET (profile_t, wall_time),
+             H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
 hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype)
 {
   //Create 1D dataspace (evt number). First dimension is unlimited (initially 0)
@@ -268,98 +340,55 @@ void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype,
   H5Sclose(memspace);
 }
 
-void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype,
-                  hsize_t counter)
-{
-  hid_t memspace, file_space;
-  //Create memspace for one more row
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
 
-  //Extend dataset
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
 
-  //Write waveforms
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsData);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-void writeSnsTof(sns_tof_t* snsTof, hid_t dataset, hid_t memtype,
+void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype,
                  hsize_t counter)
 {
   hid_t memspace, file_space;
-  //Create memspace for one more SiPM row
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
-
-  //Extend SiPM dataset
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  //Write SiPM waveforms
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsTof);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-
-void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype,
-              hsize_t counter)
-{
-  hid_t memspace, file_space;
-
+  //Create memspace for one more row
   const hsize_t n_dims = 1;
   hsize_t dims[n_dims] = {1};
   memspace = H5Screate_simple(n_dims, dims, NULL);
 
+  //Extend dataset
   dims[0] = counter+1;
   H5Dset_extent(dataset, dims);
 
+  //Write waveforms
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
   hsize_t count[1] = {1};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, hitInfo);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsPos);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
 
-void writeParticle(particle_info_t* particleInfo, hid_t dataset,
-                   hid_t memtype, hsize_t counter)
+void writeRows(const void* rows, hsize_t n_rows, hid_t dataset,
+               hid_t memtype, hsize_t counter)
 {
   hid_t memspace, file_space;
-
+  //Create memspace for all the rows
   const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
+  hsize_t dims[n_dims] = {n_rows};
   memspace = H5Screate_simple(n_dims, dims, NULL);
 
-  dims[0] = counter+1;
+  //Extend dataset
+  dims[0] = counter+n_rows;
   H5Dset_extent(dataset, dims);
 
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
+  hsize_t count[1] = {n_rows};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, particleInfo);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, rows);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
 
-
-void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype,
-                 hsize_t counter)
+void writeLUTPoint(lut_point_t* lutPoint, hid_t dataset, hid_t memtype,
+                   hsize_t counter)
 {
   hid_t memspace, file_space;
   //Create memspace for one more row
@@ -371,55 +400,55 @@ void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype,
   dims[0] = counter+1;
   H5Dset_extent(dataset, dims);
 
-  //Write waveforms
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
   hsize_t count[1] = {1};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsPos);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, lutPoint);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
 
-void writeStep(step_info_t* step, hid_t dataset, hid_t memtype, hsize_t counter)
+void writeLUT(lut_t* lut, hsize_t n_rows, hid_t dataset, hid_t memtype,
+              hsize_t counter)
 {
   hid_t memspace, file_space;
-
+  //Create memspace for all the rows of one point
   const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
+  hsize_t dims[n_dims] = {n_rows};
   memspace = H5Screate_simple(n_dims, dims, NULL);
 
-  dims[0] = counter + 1;
+  //Extend dataset
+  dims[0] = counter+n_rows;
   H5Dset_extent(dataset, dims);
 
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
+  hsize_t count[1] = {n_rows};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, step);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, lut);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
 
-void writeChargeData(charge_data_t* chargeData, hid_t dataset, hid_t memtype,
-                     hsize_t counter)
+void writeSensPoints(sens_point_t* sensPoints, hsize_t n_rows, hid_t dataset,
+                     hid_t memtype, hsize_t counter)
 {
   hid_t memspace, file_space;
-  //Create memspace for one more row
+  //Create memspace for all the points
   const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
+  hsize_t dims[n_dims] = {n_rows};
   memspace = H5Screate_simple(n_dims, dims, NULL);
 
   //Extend dataset
-  dims[0] = counter+1;
+  dims[0] = counter+n_rows;
   H5Dset_extent(dataset, dims);
 
-  //Write waveforms
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
+  hsize_t count[1] = {n_rows};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, chargeData);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, sensPoints);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
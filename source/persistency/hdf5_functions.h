@@ -103,6 +103,42 @@ typedef struct{
     unsigned int charge;
   } charge_data_t;
 
+  typedef struct{
+    unsigned int point_id;
+    float x;
+    float y;
+    float z;
+    unsigned int n_events;
+    double n_photons;
+  } lut_point_t;
+
+  typedef struct{
+    unsigned int point_id;
+    unsigned int sensor_id;
+    float probability;
+    float counts;
+    float mean_time;
+    float rms_time;
+  } lut_t;
+
+  typedef struct{
+    unsigned int point_id;
+    float x;
+    float y;
+    float z;
+    unsigned int n_generated;
+    unsigned int n_selected;
+    unsigned int n_coincidences;
+  } sens_point_t;
+
+  typedef struct{
+    int32_t event_id;
+    char particle_name[STRLEN];
+    uint64_t n_tracks;
+    uint64_t n_steps;
+    float wall_time;
+  } profile_t;
+
   hsize_t createRunType();
   hsize_t createSensorDataType();
   hsize_t createSensorTofType();
@@ -111,26 +147,26 @@ typedef struct{
   hsize_t createSensorPosType();
   hsize_t createStepType();
   hsize_t createChargeDataType();
+  hsize_t createLUTPointType();
+  hsize_t createLUTType();
+  hsize_t createSensPointType();
+  hsize_t createProfileType();
 
   hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype);
   hid_t createGroup(hid_t file, std::string& groupName);
 
   void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype,
                 hsize_t counter);
-  void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype,
-                    hsize_t counter);
-  void writeSnsTof(sns_tof_t* snsTof, hid_t dataset, hid_t memtype,
-                   hsize_t counter);
-  void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype,
-                hsize_t counter);
-  void writeParticle(particle_info_t* particleInfo, hid_t dataset,
-                     hid_t memtype, hsize_t counter);
   void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype,
                    hsize_t counter);
-  void writeStep(step_info_t* step, hid_t dataset, hid_t memtype,
-                 hsize_t counter);
-  void writeChargeData(charge_data_t* chargeData, hid_t dataset, hid_t memtype,
-                       hsize_t counter);
+  void writeRows(const void* rows, hsize_t n_rows, hid_t dataset,
+                 hid_t memtype, hsize_t counter);
+  void writeLUTPoint(lut_point_t* lutPoint, hid_t dataset, hid_t memtype,
+                     hsize_t counter);
+  void writeLUT(lut_t* lut, hsize_t n_rows, hid_t dataset, hid_t memtype,
+                hsize_t counter);
+  void writeSensPoints(sens_point_t* sensPoints, hsize_t n_rows,
+                       hid_t dataset, hid_t memtype, hsize_t counter);
 
 
 #endif
@@ -0,0 +1,279 @@
+// ----------------------------------------------------------------------------
+// petalosim | petalo-bench.cc
+//
+// Benchmark driver of petalosim. It runs bin/petalo on a fixed set of
+// seeded workloads, built from the macros of the macros directory, and
+// reports for each of them the startup time, the events per second, the
+// peak resident memory and the output size per event as JSON.
+// It must be run from the top directory of petalosim.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+
+namespace {
+
+  struct Workload {
+    const char* name;
+    const char* macro; // base name of the macros in the macros directory
+    const char* extra; // commands added to the configuration macro
+    const char* stacking = nullptr; // stacking action replacing the one
+                                    // registered in the init macro
+    const char* note = nullptr;     // caveat written in the report
+  };
+
+  // Full body with back-to-back gammas (also with the SiPMs placed as a
+  // parameterised volume, and with the optical photons transported by the
+  // ray tracer instead of Geant4), PETit tiles, the NEST ring, the
+  // sensitivity map and the NEST ring with the Jaszczak phantom
+  const Workload workloads[] = {
+    {"full_body",       "PET_full_body", ""},
+    {"full_body_param", "PET_full_body",
+     "/Geometry/FullRingInfinity/parameterised_sensors true\n"},
+    {"full_body_rt",    "PET_full_body", "", "PetRayTracingStackingAction",
+     "optical photons of all the events are traced: the energy window of "
+     "PetaloStackingAction used by full_body is not applied"},
+    {"petit_tiles",     "PETit_tiles", ""},
+    {"nest_ring",       "PET_full_body_nest", ""},
+    {"sensitivity_map", "PET_full_body_sens", ""},
+    {"phantom",         "PET_full_body_nest_phantom", ""},
+  };
+
+  const long bench_seed = 20201606;
+
+  struct Result {
+    bool   ok;
+    double wall_time; // s
+    long   peak_rss;  // kB
+  };
+
+  void PrintUsage()
+  {
+    std::cerr << "\nUsage: bin/petalo-bench [-n number] [-w workload] "
+              << "[-o output.json] [-p petalo] [-d directory]\n\n"
+              << "Available options:\n"
+              << "   -n, --nevents   : Number of events of each workload (default 10)\n"
+              << "   -w, --workload  : Run only the given workload (can be repeated)\n"
+              << "   -o, --output    : Write the JSON report to a file instead of stdout\n"
+              << "   -p, --petalo    : petalosim executable (default bin/petalo)\n"
+              << "   -d, --directory : Directory for macros, logs and output files\n"
+              << "                     (default petalo-bench.out)\n"
+              << "\nWorkloads:";
+    for (auto& w: workloads) std::cerr << " " << w.name;
+    std::cerr << "\n" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+
+  // Write the macros of a workload, reading the ones of the macros
+  // directory and fixing the seed and the output file
+  bool WriteMacros(const Workload& w, const std::string& dir,
+                   const std::string& tag, std::string& init_path,
+                   std::string& output_base)
+  {
+    std::string base   = std::string("macros/") + w.macro;
+    std::string config_path = dir + "/" + w.name + tag + ".config.mac";
+    init_path   = dir + "/" + w.name + tag + ".init.mac";
+    output_base = dir + "/" + w.name + tag;
+
+    std::ifstream init_in(base + ".init.mac");
+    std::ifstream config_in(base + ".config.mac");
+    if (!init_in.good() || !config_in.good()) {
+      std::cerr << "Cannot read the macros " << base << ".*.mac" << std::endl;
+      return false;
+    }
+
+    std::ofstream init_out(init_path);
+    std::string line;
+    while (std::getline(init_in, line)) {
+      if (line.rfind("/nexus/RegisterMacro", 0) == 0)
+        init_out << "/nexus/RegisterMacro " << config_path << "\n";
+      else if (w.stacking && line.rfind("/nexus/RegisterStackingAction", 0) == 0)
+        init_out << "/nexus/RegisterStackingAction " << w.stacking << "\n";
+      else
+        init_out << line << "\n";
+    }
+
+    // Commands given later override the ones of the original macro
+    std::ofstream config_out(config_path);
+    config_out << config_in.rdbuf() << "\n"
+               << w.extra
+               << "/run/verbose 0\n"
+               << "/nexus/random_seed " << bench_seed << "\n"
+               << "/petalosim/persistency/start_id 0\n"
+               << "/petalosim/persistency/output_file " << output_base << "\n";
+    return true;
+  }
+
+
+  // Run petalo in a child process and collect its resource usage
+  Result Run(const std::string& petalo, const std::string& init_path,
+             int nevents, const std::string& log_path)
+  {
+    Result result{false, 0., 0};
+
+    std::string n = std::to_string(nevents);
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      return result;
+    }
+    if (pid == 0) {
+      int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+      }
+      execl(petalo.c_str(), petalo.c_str(), "-b", "-n", n.c_str(),
+            init_path.c_str(), (char*) 0);
+      perror("execl");
+      _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+      perror("wait4");
+      return result;
+    }
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    result.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    result.wall_time = elapsed.count();
+    result.peak_rss  = usage.ru_maxrss; // kB on Linux
+    return result;
+  }
+
+
+  long FileSize(const std::string& path)
+  {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_size : 0;
+  }
+
+} // namespace
+
+
+
+int main(int argc, char** argv)
+{
+  int nevents = 10;
+  std::string petalo = "bin/petalo";
+  std::string dir    = "petalo-bench.out";
+  std::string output = "";
+  std::vector<std::string> selected;
+
+  static struct option long_options[] =
+  {
+    {"nevents",   required_argument, 0, 'n'},
+    {"workload",  required_argument, 0, 'w'},
+    {"output",    required_argument, 0, 'o'},
+    {"petalo",    required_argument, 0, 'p'},
+    {"directory", required_argument, 0, 'd'},
+    {"help",      no_argument,       0, 'h'},
+    {0, 0, 0, 0}
+  };
+
+  int c;
+  while ((c = getopt_long(argc, argv, "n:w:o:p:d:h", long_options, 0)) != -1) {
+    switch (c) {
+      case 'n': nevents = atoi(optarg); break;
+      case 'w': selected.push_back(optarg); break;
+      case 'o': output = optarg; break;
+      case 'p': petalo = optarg; break;
+      case 'd': dir = optarg; break;
+      default: PrintUsage();
+    }
+  }
+  if (nevents <= 0) PrintUsage();
+  for (auto& s: selected) {
+    bool found = false;
+    for (auto& w: workloads) found |= (s == w.name);
+    if (!found) PrintUsage();
+  }
+
+  mkdir(dir.c_str(), 0755);
+
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"nevents\": " << nevents << ",\n"
+       << "  \"seed\": " << bench_seed << ",\n"
+       << "  \"workloads\": [";
+
+  bool all_ok = true;
+  bool first  = true;
+  for (auto& w: workloads) {
+    if (!selected.empty() &&
+        std::find(selected.begin(), selected.end(), w.name) == selected.end())
+      continue;
+
+    std::cerr << "Running " << w.name << "..." << std::endl;
+
+    // The startup time is measured with a run without events
+    std::string init0, out0, init, out;
+    if (!WriteMacros(w, dir, "_startup", init0, out0) ||
+        !WriteMacros(w, dir, "",         init,  out)) {
+      all_ok = false;
+      continue;
+    }
+    Result startup = Run(petalo, init0, 0, out0 + ".log");
+    Result run     = Run(petalo, init,  nevents, out + ".log");
+
+    bool ok = startup.ok && run.ok;
+    all_ok &= ok;
+
+    double event_time = run.wall_time - startup.wall_time;
+    double rate = event_time > 0. ? nevents / event_time : 0.;
+    // The tables written without events are not counted per event
+    long bytes  = FileSize(out + ".h5");
+    long event_bytes = std::max(bytes - FileSize(out0 + ".h5"), 0L);
+
+    json << (first ? "\n" : ",\n")
+         << "    {\n"
+         << "      \"name\": \"" << w.name << "\",\n"
+         << "      \"macro\": \"macros/" << w.macro << "\",\n";
+    if (w.note)
+      json << "      \"note\": \"" << w.note << "\",\n";
+    json << "      \"ok\": " << (ok ? "true" : "false") << ",\n"
+         << "      \"startup_time_s\": " << startup.wall_time << ",\n"
+         << "      \"wall_time_s\": " << run.wall_time << ",\n"
+         << "      \"events_per_s\": " << rate << ",\n"
+         << "      \"peak_rss_kb\": " << run.peak_rss << ",\n"
+         << "      \"output_bytes\": " << bytes << ",\n"
+         << "      \"output_bytes_per_event\": " << (double) event_bytes / nevents << "\n"
+         << "    }";
+    first = false;
+  }
+  json << "\n  ]\n}\n";
+
+  if (output.empty()) {
+    std::cout << json.str();
+  } else {
+    std::ofstream out_file(output);
+    out_file << json.str();
+  }
+
+  return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,6 +3,8 @@
 
 // Let Catch provide main():
 #define CATCH_CONFIG_MAIN
+// Allow BENCHMARK sections (run them with: bin/petalo-test "[benchmark]")
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include <catch.hpp>
 
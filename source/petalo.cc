@@ -6,6 +6,9 @@
 // The PETALO Collaboration
 // ----------------------------------------------------------------------------
 
+#include "EventSeeder.h"
+#include "NavigationBenchmark.h"
+
 #include "nexus/NexusApp.h"
 
 #include <G4UImanager.hh>
@@ -99,9 +102,25 @@ G4int main(int argc, char** argv)
   ////////////////////////////////////////////////////////////////////
 
 
+  // Created before the macros are read, so that its commands are available
+  EventSeeder::Instance();
+  NavigationBenchmark::Instance();
+
+  // NexusApp is a sequential G4RunManager: multithreading is not enabled.
+  // The thread-local hit allocator and the per-instance caches of the
+  // actions only prepare for it. Worker threads also need nexus to build
+  // the sensitive detectors in ConstructSDandField(), per-worker
+  // trajectory maps and a merge of the output of the workers.
   NexusApp* app = new NexusApp(macro_filename);
   app->Initialize();
 
+  // Per-event seeding for any generator
+  EventSeeder::Instance().WrapPrimaryGeneration();
+
+  // Benchmark requested in the configuration macros, now that
+  // the geometry is built
+  NavigationBenchmark::Instance().RunPending();
+
   G4UImanager* UI = G4UImanager::GetUIpointer();
 
   // if (seed < 0) CLHEP::HepRandom::setTheSeed(time(0));
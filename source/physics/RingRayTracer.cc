@@ -0,0 +1,389 @@
+// ----------------------------------------------------------------------------
+// petalosim | RingRayTracer.cc
+//
+// Analytic optical transport of the scintillation photons produced
+// in the LXe ring of FullRingInfinity. Photons are traced in batches
+// through an annulus of LXe limited by the two sensor faces and the lateral
+// kapton panels, with absorption, Rayleigh scattering, Fresnel reflection at
+// the sensor windows and Lambertian reflection at the walls.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "RingRayTracer.h"
+#include "ToFSD.h"
+
+#include <G4MaterialPropertiesTable.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <cfloat>
+#include <cmath>
+
+using namespace CLHEP;
+
+
+RingRayTracer::RingRayTracer():
+  r_in_(0.), r_out_(0.), half_length_(0.),
+  n_rows_(0), pitch_(0.),
+  sipm_size_(0.), window_rindex_(1.), window_thickn_(0.), pde_(1.),
+  wall_refl_(0.), max_interactions_(1000),
+  rindex_(0), groupvel_(0), abslength_(0), rayleigh_(0)
+{
+  for (G4int f=0; f<2; f++) {
+    instrumented_[f] = false;
+    n_phi_[f]        = 0;
+    first_id_[f]     = 0;
+    pd_radius_[f]    = 0.;
+  }
+}
+
+
+
+RingRayTracer::~RingRayTracer()
+{
+}
+
+
+
+void RingRayTracer::SetRing(G4double inner_radius, G4double outer_radius,
+                            G4double length)
+{
+  r_in_        = inner_radius;
+  r_out_       = outer_radius;
+  half_length_ = length/2.;
+}
+
+
+
+void RingRayTracer::SetSensorFace(G4int face, G4int n_phi, G4int n_rows,
+                                  G4double pitch, G4int first_id,
+                                  G4double photodiode_radius)
+{
+  instrumented_[face] = true;
+  n_phi_[face]        = n_phi;
+  n_rows_             = n_rows;
+  pitch_              = pitch;
+  first_id_[face]     = first_id;
+  pd_radius_[face]    = photodiode_radius;
+}
+
+
+
+void RingRayTracer::SetSensors(G4double size, G4double window_rindex,
+                               G4double window_thickness, G4double efficiency)
+{
+  sipm_size_     = size;
+  window_rindex_ = window_rindex;
+  window_thickn_ = window_thickness;
+  pde_           = efficiency;
+}
+
+
+
+void RingRayTracer::SetMaterialProperties(G4MaterialPropertiesTable* mpt)
+{
+  rindex_    = mpt->GetProperty("RINDEX");
+  groupvel_  = mpt->GetProperty("GROUPVEL");
+  abslength_ = mpt->GetProperty("ABSLENGTH");
+  rayleigh_  = mpt->GetProperty("RAYLEIGH");
+
+  if (!rindex_)
+    G4Exception("[RingRayTracer]", "SetMaterialProperties()", FatalException,
+                "The LXe refractive index is needed to trace photons.");
+}
+
+
+
+G4bool RingRayTracer::Contains(const G4ThreeVector& pos) const
+{
+  G4double r2 = pos.x()*pos.x() + pos.y()*pos.y();
+  return (r2 >= r_in_*r_in_) && (r2 <= r_out_*r_out_) &&
+    (std::abs(pos.z()) <= half_length_);
+}
+
+
+
+void RingRayTracer::AddPhoton(const G4ThreeVector& pos,
+                              const G4ThreeVector& dir,
+                              G4double energy, G4double time, G4int track_id)
+{
+  x_.push_back(pos.x());
+  y_.push_back(pos.y());
+  z_.push_back(pos.z());
+  dx_.push_back(dir.x());
+  dy_.push_back(dir.y());
+  dz_.push_back(dir.z());
+  t_.push_back(time);
+  energy_.push_back(energy);
+  track_id_.push_back(track_id);
+  n_int_.push_back(0);
+}
+
+
+
+void RingRayTracer::Clear()
+{
+  x_.clear();  y_.clear();  z_.clear();
+  dx_.clear(); dy_.clear(); dz_.clear();
+  t_.clear();
+  energy_.clear();
+  track_id_.clear();
+  n_int_.clear();
+  n_.clear();
+  inv_vg_.clear();
+  labs_.clear();
+  lray_.clear();
+}
+
+
+
+void RingRayTracer::Trace(ToFSD* sd)
+{
+  // Look up the optical properties once per photon
+  size_t n = x_.size();
+  n_.resize(n);
+  inv_vg_.resize(n);
+  labs_.resize(n);
+  lray_.resize(n);
+  for (size_t i=0; i<n; i++) {
+    G4double e = energy_[i];
+    n_[i]      = rindex_->Value(e);
+    G4double vg = groupvel_ ? groupvel_->Value(e) : c_light/n_[i];
+    inv_vg_[i] = 1./vg;
+    labs_[i]   = abslength_ ? abslength_->Value(e) : DBL_MAX;
+    lray_[i]   = rayleigh_  ? rayleigh_->Value(e)  : DBL_MAX;
+  }
+
+  const G4double r_in2  = r_in_  * r_in_;
+  const G4double r_out2 = r_out_ * r_out_;
+
+  while (n > 0) {
+
+    rnd_.resize(2*n);
+    type_.resize(n);
+    G4Random::getTheEngine()->flatArray(2*n, rnd_.data());
+
+    // Propagation kernel: distance to the next interaction point and
+    // transport of the photon up to it. The loop has no calls apart from
+    // the maths functions and only uses selects, so that it can be
+    // auto-vectorized.
+    for (size_t i=0; i<n; i++) {
+      G4double x = x_[i], y = y_[i], z = z_[i];
+      G4double dx = dx_[i], dy = dy_[i], dz = dz_[i];
+
+      G4double a  = dx*dx + dy*dy;
+      G4double b  = x*dx + y*dy;
+      G4double r2 = x*x + y*y;
+
+      G4double disc_out = std::max(b*b - a*(r2 - r_out2), 0.);
+      G4double s_out = a > 0. ? (-b + std::sqrt(disc_out))/a : DBL_MAX;
+
+      G4double disc_in = b*b - a*(r2 - r_in2);
+      G4double s_in = (b < 0. && disc_in > 0.) ?
+        (-b - std::sqrt(std::max(disc_in, 0.)))/a : DBL_MAX;
+
+      G4double s_z = dz > 0. ? (half_length_ - z)/dz :
+        (dz < 0. ? (-half_length_ - z)/dz : DBL_MAX);
+
+      G4double s_abs = -std::log(rnd_[2*i])   * labs_[i];
+      G4double s_ray = -std::log(rnd_[2*i+1]) * lray_[i];
+
+      G4double s = s_abs;
+      G4int type = kAbsorption;
+      type = s_ray < s ? kRayleigh : type;
+      s    = s_ray < s ? s_ray : s;
+      type = s_out < s ? kOuter : type;
+      s    = s_out < s ? s_out : s;
+      type = s_in < s ? kInner : type;
+      s    = s_in < s ? s_in : s;
+      type = s_z < s ? kLateral : type;
+      s    = s_z < s ? s_z : s;
+
+      x_[i] = x + s*dx;
+      y_[i] = y + s*dy;
+      z_[i] = z + s*dz;
+      t_[i] += s * inv_vg_[i];
+      type_[i] = type;
+    }
+
+    // Interactions. The loop runs backwards so that removed photons
+    // can be replaced by the last one of the batch.
+    for (size_t k=n; k-- > 0;) {
+
+      G4bool done = false;
+      n_int_[k]++;
+
+      if (type_[k] == kAbsorption) {
+        done = true;
+      }
+      else if (type_[k] == kRayleigh) {
+        Scatter(k);
+      }
+      else if (type_[k] == kOuter) {
+        done = HitFace(k, 1, sd);
+      }
+      else if (type_[k] == kInner) {
+        done = HitFace(k, 0, sd);
+      }
+      else {
+        // Lateral kapton panels
+        if (G4UniformRand() < wall_refl_) {
+          G4double nz = z_[k] > 0. ? -1. : 1.;
+          LambertianReflection(k, G4ThreeVector(0., 0., nz));
+        } else {
+          done = true;
+        }
+      }
+
+      if (done || n_int_[k] > max_interactions_)
+        Remove(k);
+    }
+
+    n = x_.size();
+  }
+
+  Clear();
+}
+
+
+
+G4bool RingRayTracer::HitFace(size_t i, G4int face, ToFSD* sd)
+{
+  G4double r = std::sqrt(x_[i]*x_[i] + y_[i]*y_[i]);
+  // Normal to the face pointing into the LXe
+  G4double sign = (face == 1) ? -1. : 1.;
+  G4ThreeVector normal(sign * x_[i]/r, sign * y_[i]/r, 0.);
+
+  // Find the sensor in front of the photon, if any. Sensors are placed
+  // at angle i*step, with position (-r sin(angle), r cos(angle), z).
+  G4bool on_sensor = false;
+  G4int i_phi = 0, row = 0;
+  if (instrumented_[face]) {
+    G4double step  = twopi / n_phi_[face];
+    G4double angle = std::atan2(-x_[i], y_[i]);
+    if (angle < 0.) angle += twopi;
+    i_phi = (G4int)std::floor(angle/step + 0.5);
+    G4double u = r * (angle - i_phi * step);
+    if (i_phi == n_phi_[face]) i_phi = 0;
+
+    row = (G4int)std::floor((z_[i] + half_length_) / pitch_);
+    row = std::min(std::max(row, 0), n_rows_ - 1);
+    G4double v = z_[i] - (-half_length_ + (row + 0.5) * pitch_);
+
+    on_sensor = (std::abs(u) < sipm_size_/2.) && (std::abs(v) < sipm_size_/2.);
+  }
+
+  if (!on_sensor) {
+    // Gap between sensors or non-instrumented face: kapton behind
+    if (G4UniformRand() < wall_refl_) {
+      LambertianReflection(i, normal);
+      return false;
+    }
+    return true;
+  }
+
+  // Fresnel reflection at the LXe-window interface, averaged
+  // over polarizations
+  G4ThreeVector dir(dx_[i], dy_[i], dz_[i]);
+  G4double cos_i = -dir.dot(normal);
+  G4double n1 = n_[i];
+  G4double n2 = window_rindex_;
+  G4double sin_t = n1/n2 * std::sqrt(std::max(1. - cos_i*cos_i, 0.));
+
+  G4double refl = 1.;
+  G4double cos_t = 0.;
+  if (sin_t < 1.) {
+    cos_t = std::sqrt(1. - sin_t*sin_t);
+    G4double rs = (n1*cos_i - n2*cos_t) / (n1*cos_i + n2*cos_t);
+    G4double rp = (n1*cos_t - n2*cos_i) / (n1*cos_t + n2*cos_i);
+    refl = 0.5 * (rs*rs + rp*rp);
+  }
+
+  if (G4UniformRand() < refl) {
+    dir += 2. * cos_i * normal;
+    dx_[i] = dir.x();
+    dy_[i] = dir.y();
+    dz_[i] = dir.z();
+    return false;
+  }
+
+  // Transmitted photons are absorbed in the photodiodes,
+  // which have no reflectivity
+  if (G4UniformRand() < pde_) {
+    G4double time = t_[i] + window_thickn_ / cos_t * n2 / c_light;
+    G4double step = twopi / n_phi_[face];
+    G4double R = pd_radius_[face];
+    G4ThreeVector pos(-R * std::sin(i_phi * step), R * std::cos(i_phi * step),
+                      -half_length_ + (row + 0.5) * pitch_);
+    G4int sns_id = first_id_[face] + row * n_phi_[face] + i_phi;
+    sd->AddDetectedPhoton(sns_id, pos, time, track_id_[i]);
+  }
+
+  return true;
+}
+
+
+
+void RingRayTracer::Scatter(size_t i)
+{
+  // Unpolarized Rayleigh scattering: cos(theta) follows (1 + cos^2),
+  // which can be inverted analytically (Cardano)
+  G4double q = 4.*G4UniformRand() - 2.;
+  G4double d = std::sqrt(q*q + 1.);
+  G4double cos_th = std::cbrt(q + d) + std::cbrt(q - d);
+  G4double sin_th = std::sqrt(std::max(1. - cos_th*cos_th, 0.));
+  G4double phi = twopi * G4UniformRand();
+
+  G4ThreeVector dir(sin_th*std::cos(phi), sin_th*std::sin(phi), cos_th);
+  dir.rotateUz(G4ThreeVector(dx_[i], dy_[i], dz_[i]));
+
+  dx_[i] = dir.x();
+  dy_[i] = dir.y();
+  dz_[i] = dir.z();
+}
+
+
+
+void RingRayTracer::LambertianReflection(size_t i, const G4ThreeVector& normal)
+{
+  G4double cos_th = std::sqrt(G4UniformRand());
+  G4double sin_th = std::sqrt(1. - cos_th*cos_th);
+  G4double phi = twopi * G4UniformRand();
+
+  G4ThreeVector dir(sin_th*std::cos(phi), sin_th*std::sin(phi), cos_th);
+  dir.rotateUz(normal);
+
+  dx_[i] = dir.x();
+  dy_[i] = dir.y();
+  dz_[i] = dir.z();
+}
+
+
+
+void RingRayTracer::Remove(size_t i)
+{
+  size_t last = x_.size() - 1;
+  x_[i]  = x_[last];  y_[i]  = y_[last];  z_[i]  = z_[last];
+  dx_[i] = dx_[last]; dy_[i] = dy_[last]; dz_[i] = dz_[last];
+  t_[i]        = t_[last];
+  energy_[i]   = energy_[last];
+  track_id_[i] = track_id_[last];
+  n_int_[i]    = n_int_[last];
+  n_[i]        = n_[last];
+  inv_vg_[i]   = inv_vg_[last];
+  labs_[i]     = labs_[last];
+  lray_[i]     = lray_[last];
+
+  x_.pop_back();  y_.pop_back();  z_.pop_back();
+  dx_.pop_back(); dy_.pop_back(); dz_.pop_back();
+  t_.pop_back();
+  energy_.pop_back();
+  track_id_.pop_back();
+  n_int_.pop_back();
+  n_.pop_back();
+  inv_vg_.pop_back();
+  labs_.pop_back();
+  lray_.pop_back();
+}
@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// petalosim | RingRayTracer.h
+//
+// Analytic optical transport of the scintillation photons produced
+// in the LXe ring of FullRingInfinity. Photons are traced in batches
+// through an annulus of LXe limited by the two sensor faces and the lateral
+// kapton panels, with absorption, Rayleigh scattering, Fresnel reflection at
+// the sensor windows and Lambertian reflection at the walls.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef RING_RAY_TRACER_H
+#define RING_RAY_TRACER_H
+
+#include <G4ThreeVector.hh>
+#include <vector>
+
+class G4MaterialPropertiesTable;
+class G4MaterialPropertyVector;
+class ToFSD;
+
+class RingRayTracer
+{
+public:
+  /// Constructor
+  RingRayTracer();
+  /// Destructor
+  ~RingRayTracer();
+
+  /// Set the radial and axial limits of the LXe traced analytically
+  void SetRing(G4double inner_radius, G4double outer_radius,
+               G4double length);
+  /// Set one instrumented face (0: inner, 1: outer). The sensor ids are
+  /// first_id + row * n_phi + i_phi, as in FullRingInfinity::BuildSensors
+  void SetSensorFace(G4int face, G4int n_phi, G4int n_rows, G4double pitch,
+                     G4int first_id, G4double photodiode_radius);
+  /// Set the properties of the sensors
+  void SetSensors(G4double size, G4double window_rindex,
+                  G4double window_thickness, G4double efficiency);
+  /// Set the reflectivity of the walls (kapton and gaps between sensors)
+  void SetWallReflectivity(G4double refl);
+  /// Set the optical properties of LXe
+  void SetMaterialProperties(G4MaterialPropertiesTable* mpt);
+
+  /// Return true if the point is inside the region traced analytically
+  G4bool Contains(const G4ThreeVector& pos) const;
+
+  /// Add a photon to the current batch
+  void AddPhoton(const G4ThreeVector& pos, const G4ThreeVector& dir,
+                 G4double energy, G4double time, G4int track_id);
+  /// Number of photons waiting in the current batch
+  size_t GetNumberOfPhotons() const;
+
+  /// Propagate all the photons of the batch until they are absorbed or
+  /// detected, adding the detected ones to the given sensitive detector.
+  /// The batch is emptied.
+  void Trace(ToFSD* sd);
+
+  /// Discard the photons of the current batch
+  void Clear();
+
+private:
+  /// Possible outcomes of each propagation step
+  enum StepType { kAbsorption, kRayleigh, kOuter, kInner, kLateral };
+
+  void Scatter(size_t i);
+  void LambertianReflection(size_t i, const G4ThreeVector& normal);
+  /// Photon reaching one of the faces. Returns true if the photon is
+  /// no longer propagated.
+  G4bool HitFace(size_t i, G4int face, ToFSD* sd);
+  void Remove(size_t i);
+
+  G4double r_in_, r_out_, half_length_;
+
+  // Sensor faces: inner (0) and outer (1)
+  G4bool   instrumented_[2];
+  G4int    n_phi_[2];
+  G4int    n_rows_;
+  G4double pitch_;
+  G4int    first_id_[2];
+  G4double pd_radius_[2];
+
+  G4double sipm_size_;
+  G4double window_rindex_;
+  G4double window_thickn_;
+  G4double pde_;
+  G4double wall_refl_;
+
+  G4int max_interactions_; ///< photons interacting more times are dropped
+
+  G4MaterialPropertyVector* rindex_;
+  G4MaterialPropertyVector* groupvel_;
+  G4MaterialPropertyVector* abslength_;
+  G4MaterialPropertyVector* rayleigh_;
+
+  // Photon batch, stored as a structure of arrays so that the
+  // propagation kernel runs over contiguous memory
+  std::vector<G4double> x_, y_, z_;
+  std::vector<G4double> dx_, dy_, dz_;
+  std::vector<G4double> t_;
+  std::vector<G4double> energy_;
+  std::vector<G4int>    track_id_;
+  std::vector<G4int>    n_int_;
+
+  // Per-photon values of the optical properties, filled before tracing
+  std::vector<G4double> n_;
+  std::vector<G4double> inv_vg_;
+  std::vector<G4double> labs_;
+  std::vector<G4double> lray_;
+
+  // Work arrays of the propagation kernel
+  std::vector<G4double> rnd_;
+  std::vector<G4int>    type_;
+};
+
+inline size_t RingRayTracer::GetNumberOfPhotons() const { return x_.size(); }
+
+inline void RingRayTracer::SetWallReflectivity(G4double refl)
+{ wall_refl_ = refl; }
+
+#endif
@@ -12,10 +12,13 @@
 
 #include <G4SDManager.hh>
 
+#include <cmath>
+
 using namespace CLHEP;
 
 ChargeSD::ChargeSD(G4String sdname) : G4VSensitiveDetector(sdname),
-                                      timebinning_(1.*microsecond)
+                                      timebinning_(1.*microsecond),
+                                      wire_radius_(0.), n_wires_(0)
 {
   // Register the name of the collection of hits
   collectionName.insert(GetCollectionUniqueName());
@@ -52,7 +55,16 @@ G4bool ChargeSD::ProcessHits(G4Step *step, G4TouchableHistory *)
       step->GetPreStepPoint()->GetTouchable();
 
   G4int sns_id = FindSensorID(touchable);
+  G4double time = step->GetPostStepPoint()->GetGlobalTime();
+
+  AddCharge(sns_id, touchable->GetTranslation(), time);
 
+  return true;
+}
+
+void ChargeSD::AddCharge(G4int sns_id, const G4ThreeVector& position,
+                         G4double time)
+{
   ChargeHit *hit = 0;
   for (size_t i=0; i<HC_->entries(); i++) {
     if ((*HC_)[i]->GetSensorID() == sns_id) {
@@ -67,14 +79,32 @@ G4bool ChargeSD::ProcessHits(G4Step *step, G4TouchableHistory *)
     hit = new ChargeHit();
     hit->SetSensorID(sns_id);
     hit->SetBinSize(timebinning_);
-    hit->SetPosition(touchable->GetTranslation());
+    hit->SetPosition(position);
     HC_->insert(hit);
   }
 
-  G4double time = step->GetPostStepPoint()->GetGlobalTime();
   hit->Fill(time);
+}
 
-  return true;
+void ChargeSD::SetWireRing(G4double radius, G4int n_wires)
+{
+  wire_radius_ = radius;
+  n_wires_ = n_wires;
+}
+
+G4int ChargeSD::FindWire(G4double phi) const
+{
+  G4double step = twopi / n_wires_;
+  G4int wire_id = std::lround(phi / step) % n_wires_;
+  if (wire_id < 0) wire_id += n_wires_;
+  return wire_id;
+}
+
+G4ThreeVector ChargeSD::GetWirePosition(G4int wire_id) const
+{
+  G4double angle = wire_id * twopi / n_wires_;
+  return G4ThreeVector(-wire_radius_ * std::sin(angle),
+                       wire_radius_ * std::cos(angle), 0.);
 }
 
 G4int ChargeSD::FindSensorID(const G4VTouchable* touchable)
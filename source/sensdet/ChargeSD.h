@@ -37,6 +37,22 @@ public:
   /// Set a time binning for the hits
   void SetTimeBinning(G4double);
 
+  /// Set the ring of wires read by this detector: n_wires wires at
+  /// the given radius, the first one along the +y axis and the rest
+  /// rotated counterclockwise around z.
+  void SetWireRing(G4double radius, G4int n_wires);
+  G4double GetWireRadius() const;
+  G4int GetNumberOfWires() const;
+  /// Return the ID of the wire closest to the azimuthal angle phi,
+  /// measured from the +y axis
+  G4int FindWire(G4double phi) const;
+  /// Return the position of the centre of a wire
+  G4ThreeVector GetWirePosition(G4int wire_id) const;
+
+  /// Add one electron collected by a sensor at the given time.
+  /// Used both by the tracking and by the parametric drift of electrons.
+  void AddCharge(G4int sns_id, const G4ThreeVector& position, G4double time);
+
   /// Return the unique name of the hits collection created
   /// by this sensitive detector. This will be used by the
   /// persistency manager to select the collection.
@@ -51,9 +67,14 @@ public:
 
   G4double timebinning_; ///< Time bin width
 
+  G4double wire_radius_; ///< Radius of the ring of wires
+  G4int n_wires_;        ///< Number of wires in the ring
+
 };
 
 inline G4double ChargeSD::GetTimeBinning() const { return timebinning_; }
 inline void ChargeSD::SetTimeBinning(G4double tb) { timebinning_ = tb; }
+inline G4double ChargeSD::GetWireRadius() const { return wire_radius_; }
+inline G4int ChargeSD::GetNumberOfWires() const { return n_wires_; }
 
 #endif
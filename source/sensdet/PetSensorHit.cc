@@ -9,7 +9,7 @@
 #include "PetSensorHit.h"
 
 
-G4Allocator<PetSensorHit> PetSensorHitAllocator;
+G4ThreadLocal G4Allocator<PetSensorHit>* PetSensorHitAllocator = 0;
 
 
 
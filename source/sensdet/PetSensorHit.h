@@ -66,16 +66,21 @@ private:
 
 
 typedef G4THitsCollection<PetSensorHit> PetSensorHitsCollection;
-extern G4Allocator<PetSensorHit> PetSensorHitAllocator;
+/// One allocator per thread, created with the first hit of the thread
+extern G4ThreadLocal G4Allocator<PetSensorHit>* PetSensorHitAllocator;
 
 
 // INLINE DEFINITIONS ////////////////////////////////////////////////
 
 inline void* PetSensorHit::operator new(size_t)
-{ return ((void*) PetSensorHitAllocator.MallocSingle()); }
+{
+  if (!PetSensorHitAllocator)
+    PetSensorHitAllocator = new G4Allocator<PetSensorHit>;
+  return ((void*) PetSensorHitAllocator->MallocSingle());
+}
 
 inline void PetSensorHit::operator delete(void* hit)
-{ PetSensorHitAllocator.FreeSingle((PetSensorHit*) hit); }
+{ PetSensorHitAllocator->FreeSingle((PetSensorHit*) hit); }
 
 inline G4int PetSensorHit::GetSnsID() const { return sns_id_; }
 inline void PetSensorHit::SetSnsID(G4int id) { sns_id_ = id; }
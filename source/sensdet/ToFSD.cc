@@ -20,7 +20,8 @@
 using namespace CLHEP;
 
 ToFSD::ToFSD(G4String sdname) : G4VSensitiveDetector(sdname),
-                                naming_order_(0), sensor_depth_(0),
+                                naming_order_(0), id_offset_(0),
+                                sensor_depth_(0),
                                 mother_depth_(0),
                                 box_conf_(def), sipm_cells_(false)
 {
@@ -61,6 +62,16 @@ G4bool ToFSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 
   G4int sns_id = FindID(touchable);
 
+  G4double time = step->GetPostStepPoint()->GetGlobalTime();
+  AddDetectedPhoton(sns_id, touchable->GetTranslation(), time,
+                    step->GetTrack()->GetTrackID());
+
+  return true;
+}
+
+void ToFSD::AddDetectedPhoton(G4int sns_id, const G4ThreeVector& position,
+                              G4double time, G4int track_id)
+{
   PetSensorHit* hit = 0;
   for (size_t i = 0; i < HC_->entries(); i++)
     {
@@ -77,21 +88,18 @@ G4bool ToFSD::ProcessHits(G4Step* step, G4TouchableHistory*)
     {
       hit = new PetSensorHit();
       hit->SetSnsID(sns_id);
-      hit->SetPosition(touchable->GetTranslation());
+      hit->SetPosition(position);
       HC_->insert(hit);
     }
 
   hit->counts_ += 1;
-  G4double time = step->GetPostStepPoint()->GetGlobalTime();
-  hit->AddPhoton(time, step->GetTrack()->GetTrackID());
-
-  return true;
+  hit->AddPhoton(time, track_id);
 }
 
 G4int ToFSD::FindID(const G4VTouchable* touchable)
 {
   // This is valid for full-body PET and for PETit with FBK-only
-  G4int snsid = touchable->GetCopyNumber(sensor_depth_);
+  G4int snsid = touchable->GetCopyNumber(sensor_depth_) + id_offset_;
   if (naming_order_ != 0)
   {
     G4int motherid = touchable->GetCopyNumber(mother_depth_);
@@ -50,6 +50,8 @@ public:
   void SetDetectorNamingOrder(G4int);
   /// Return the naming order of the SD
   G4int GetDetectorNamingOrder() const;
+  /// Set the offset added to the copy number of the sensor to get its ID
+  void SetDetectorIdOffset(G4int);
 
   /// Set the depth of the SD's grandmother volume in the geometry hierarchy
   void SetGrandMotherVolumeDepth(G4int);
@@ -62,6 +64,12 @@ public:
   /// Set type of SiPM (with every microcell or not)
   void SetSiPMCells(G4bool cells);
 
+  /// Add a photon detected by a given sensor to the hits collection
+  /// of the current event. Used by ProcessHits and by optical transport
+  /// engines which do not step photons through the geometry.
+  void AddDetectedPhoton(G4int sns_id, const G4ThreeVector& position,
+                         G4double time, G4int track_id);
+
   /// Return the unique name of the hits collection created
   /// by this sensitive detector. This will be used by the
   /// persistency manager to select the collection.
@@ -73,6 +81,7 @@ private:
   G4int FindID(const G4VTouchable *);
 
   G4int naming_order_;      ///< Order of the naming scheme
+  G4int id_offset_;         ///< Offset added to the copy number of the sensor
   G4int sensor_depth_;      ///< Depth of the SD in the geometry tree
   G4int mother_depth_;      ///< Depth of the SD's mother in the geometry tree
   G4int grandmother_depth_; ///< Depth of the SD's grandmother in the geometry tree
@@ -94,6 +103,8 @@ inline G4int ToFSD::GetMotherVolumeDepth() const { return mother_depth_; }
 inline void ToFSD::SetDetectorNamingOrder(G4int o) { naming_order_ = o; }
 inline G4int ToFSD::GetDetectorNamingOrder() const { return naming_order_; }
 
+inline void ToFSD::SetDetectorIdOffset(G4int o) { id_offset_ = o; }
+
 inline void ToFSD::SetGrandMotherVolumeDepth(G4int d) { grandmother_depth_ = d; }
 inline G4int ToFSD::GetGrandMotherVolumeDepth() const { return grandmother_depth_; }
 
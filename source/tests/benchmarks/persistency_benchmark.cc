@@ -0,0 +1,67 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch.hpp>
+
+#include "HDF5Writer.h"
+#include "EventBuffer.h"
+
+#include <G4Types.hh>
+#include <Randomize.hh>
+
+#include <cstdio>
+#include <string>
+
+
+namespace {
+
+  // Rows of a typical full-body event: sensor charges, first photon
+  // times, true hits and particles
+  void FillEvent(EventBuffer& buffer, G4int event_id)
+  {
+    for (G4int i=0; i<1000; i++) {
+      unsigned int sensor_id = 1000 + (unsigned int) (G4UniformRand() * 100000);
+      buffer.AddSensorData(event_id, sensor_id, 1 + i % 7);
+      buffer.AddSensorTof(event_id, -sensor_id, G4UniformRand() * 50., i + 1);
+    }
+    for (G4int i=0; i<50; i++)
+      buffer.AddHit(event_id, i % 10 + 1, G4UniformRand(), G4UniformRand(),
+                    G4UniformRand(), G4UniformRand(), G4UniformRand(),
+                    "ACTIVE");
+    for (G4int i=0; i<10; i++)
+      buffer.AddParticle(event_id, i + 1, "e-", i < 2, i < 2 ? 0 : 1,
+                         0., 0., 0., 0., 1., 1., 1., 1., "ACTIVE", "ACTIVE",
+                         0., 0., 0.511, 0., 0., 0., 0.511, 10., "none",
+                         "eIoni");
+  }
+
+} // namespace
+
+
+TEST_CASE("HDF5Writer benchmark", "[.][benchmark]") {
+
+  std::string filename = "petalo_bench_hdf5writer.h5";
+
+  EventBuffer buffer;
+  FillEvent(buffer, 0);
+
+  HDF5Writer writer;
+  writer.Open(filename, false);
+
+  BENCHMARK("HDF5Writer::WriteEvent, 2k sensor rows") {
+    writer.WriteEvent(buffer);
+    return buffer.GetSensorData().size();
+  };
+
+  BENCHMARK("HDF5Writer::WriteRunInfo") {
+    writer.WriteRunInfo("key", "value");
+    return 0;
+  };
+
+  BENCHMARK("EventBuffer fill, 2k sensor rows") {
+    buffer.Clear();
+    FillEvent(buffer, 1);
+    return buffer.GetSensorData().size();
+  };
+
+  writer.Close();
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,58 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch.hpp>
+
+#include "VoxelPointSampler.h"
+#include "PetaloUtils.h"
+#include "PetXenonProperties.h"
+
+#include <G4RandomDirection.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <vector>
+
+
+TEST_CASE("Vertex sampling benchmark", "[.][benchmark]") {
+
+  // Grid of the size of a whole-body activity map,
+  // as used by FullRingInfinity::RandomPointVertex
+  const G4int n = 100;
+  std::vector<G4double> activity(n * n * n);
+  for (auto& a: activity) a = G4UniformRand();
+
+  VoxelPointSampler sampler(n, n, n, 400.*mm, 400.*mm, 400.*mm);
+  sampler.SetActivity(activity);
+
+  REQUIRE(sampler.GenerateVertex().mag() < 400.*mm);
+
+  BENCHMARK("VoxelPointSampler::GenerateVertex, 100^3 voxels") {
+    return sampler.GenerateVertex();
+  };
+}
+
+
+TEST_CASE("Annihilation kinematics benchmark", "[.][benchmark]") {
+
+  G4ThreeVector dir = G4RandomDirection();
+
+  auto [dir2, e1, e2] = CalculateNonCollinearKinematicInBodyTissue(dir);
+  REQUIRE(e1 + e2 == Approx(2. * electron_mass_c2));
+  REQUIRE(dir.dot(dir2) > 0.99);
+
+  BENCHMARK("CalculateNonCollinearKinematicInBodyTissue") {
+    return CalculateNonCollinearKinematicInBodyTissue(dir);
+  };
+}
+
+
+TEST_CASE("LXe density benchmark", "[.][benchmark]") {
+
+  // Reads the table in $PETALODIR/data
+  G4double pressure = 1.5 * bar;
+  REQUIRE(GetLXeDensity(pressure) > 2800. * kg/m3);
+
+  BENCHMARK("GetLXeDensity") {
+    return GetLXeDensity(pressure);
+  };
+}
@@ -0,0 +1,137 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch.hpp>
+
+#include "ToFSD.h"
+#include "PetSensorHit.h"
+#include "ChargeHit.h"
+
+#include <G4SDManager.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4Step.hh>
+#include <G4StepPoint.hh>
+#include <G4Track.hh>
+#include <G4DynamicParticle.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4VTouchable.hh>
+#include <G4RotationMatrix.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+  // Touchable of a sensor with a given copy number,
+  // without any geometry behind it
+  class SyntheticTouchable : public G4VTouchable
+  {
+  public:
+    SyntheticTouchable(G4int copy_no, const G4ThreeVector& pos):
+      copy_no_(copy_no), pos_(pos) {}
+
+    const G4ThreeVector& GetTranslation(G4int) const override { return pos_; }
+    const G4RotationMatrix* GetRotation(G4int) const override { return &rot_; }
+    G4int GetReplicaNumber(G4int) const override { return copy_no_; }
+
+  private:
+    G4int copy_no_;
+    G4ThreeVector pos_;
+    G4RotationMatrix rot_;
+  };
+
+
+  // Optical photons reaching n_sensors different sensors
+  struct SyntheticSteps {
+    SyntheticSteps(G4int n_photons, G4int n_sensors)
+    {
+      for (G4int i=0; i<n_sensors; i++)
+        touchables.push_back(G4TouchableHandle(
+          new SyntheticTouchable(i, G4ThreeVector(i*mm, 0., 0.))));
+
+      for (G4int i=0; i<n_photons; i++) {
+        auto particle = new G4DynamicParticle(G4OpticalPhoton::Definition(),
+                                              G4ThreeVector(0., 0., 1.),
+                                              3. * eV);
+        auto track = std::make_unique<G4Track>(particle, 0., G4ThreeVector());
+        track->SetTrackID(i + 1);
+
+        auto step = std::make_unique<G4Step>();
+        step->SetTrack(track.get());
+        G4StepPoint* post = step->GetPostStepPoint();
+        post->SetTouchableHandle(touchables[(G4int) (G4UniformRand() * n_sensors)]);
+        post->SetGlobalTime(G4UniformRand() * 100. * ns);
+
+        tracks.push_back(std::move(track));
+        steps.push_back(std::move(step));
+      }
+    }
+
+    std::vector<G4TouchableHandle> touchables;
+    std::vector<std::unique_ptr<G4Track>> tracks;
+    std::vector<std::unique_ptr<G4Step>> steps;
+  };
+
+} // namespace
+
+
+TEST_CASE("ToFSD benchmark", "[.][benchmark]") {
+
+  G4SDManager* sdmgr = G4SDManager::GetSDMpointer();
+  ToFSD* sd = dynamic_cast<ToFSD*>(sdmgr->FindSensitiveDetector("/BENCH/ToFSD", false));
+  if (!sd) {
+    sd = new ToFSD("/BENCH/ToFSD");
+    sdmgr->AddNewDetector(sd);
+  }
+
+  // Photons of one event detected in 1000 sensors
+  const G4int n_photons = 10000;
+  SyntheticSteps input(n_photons, 1000);
+
+  G4int hcid = sdmgr->GetCollectionID("ToFSD/" + ToFSD::GetCollectionUniqueName());
+
+  auto process_event = [&]() {
+    G4HCofThisEvent hce(sdmgr->GetCollectionCapacity());
+    sd->Initialize(&hce);
+    for (auto& step: input.steps)
+      sd->Hit(step.get());
+    return hce.GetHC(hcid)->GetSize();
+  };
+
+  REQUIRE(process_event() > 0);
+
+  BENCHMARK("ToFSD::ProcessHits, 10k photons in 1k sensors") {
+    return process_event();
+  };
+}
+
+
+TEST_CASE("PetSensorHit benchmark", "[.][benchmark]") {
+
+  const G4int n_photons = 10000;
+  std::vector<G4double> times(n_photons);
+  for (auto& t: times) t = G4UniformRand() * 100. * ns;
+
+  BENCHMARK("PetSensorHit::AddPhoton, 10k photons") {
+    PetSensorHit hit(0, G4ThreeVector());
+    for (G4int i=0; i<n_photons; i++)
+      hit.AddPhoton(times[i], i + 1);
+    return hit.GetPhotonMap().size();
+  };
+}
+
+
+TEST_CASE("ChargeHit benchmark", "[.][benchmark]") {
+
+  const G4int n_charges = 10000;
+  std::vector<G4double> times(n_charges);
+  for (auto& t: times) t = G4UniformRand() * 10. * microsecond;
+
+  BENCHMARK("ChargeHit::Fill, 10k ionization electrons") {
+    ChargeHit hit;
+    hit.SetBinSize(1. * microsecond);
+    for (G4int i=0; i<n_charges; i++)
+      hit.Fill(times[i]);
+    return hit.GetChargeWaveform().size();
+  };
+}
@@ -0,0 +1,48 @@
+#include <catch.hpp>
+
+#include "PetXenonProperties.h"
+#include "PetOpticalMaterialProperties.h"
+
+#include <G4MaterialPropertiesTable.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <vector>
+
+
+TEST_CASE("LXe density interpolates the density table") {
+
+  // Reads the table in $PETALODIR/data
+  std::vector<std::vector<G4double>> data;
+  G4int n = MakeLXeDensityDataTable(data);
+  REQUIRE(n > 1);
+
+  for (auto& d: data)
+    REQUIRE(GetLXeDensity(d[1]) == d[2]);
+
+  G4double pressure = (data[0][1] + data[1][1]) / 2.;
+  REQUIRE(GetLXeDensity(pressure) == Approx((data[0][2] + data[1][2]) / 2.));
+
+  REQUIRE_THROWS(GetLXeDensity(data[0][1] / 2.));
+  REQUIRE_THROWS(GetLXeDensity(data[n-1][1] * 2.));
+}
+
+
+TEST_CASE("Optical property tables are shared") {
+
+  REQUIRE(petopticalprops::PTFE() == petopticalprops::PTFE());
+
+  G4MaterialPropertiesTable* lxe = petopticalprops::LXe(1.5 * bar);
+  REQUIRE(petopticalprops::LXe(1.5 * bar) == lxe);
+  REQUIRE(petopticalprops::LXe(2.0 * bar) != lxe);
+
+  REQUIRE(petopticalprops::ReflectantSurface(0.5) ==
+          petopticalprops::ReflectantSurface(0.5));
+  REQUIRE(petopticalprops::ReflectantSurface(0.5) !=
+          petopticalprops::ReflectantSurface(0.9));
+
+  G4int builds = 0;
+  auto build = [&builds] { builds++; return new G4MaterialPropertiesTable(); };
+  G4MaterialPropertiesTable* mpt = petopticalprops::Memoize("test", {1.}, build);
+  REQUIRE(petopticalprops::Memoize("test", {1.}, build) == mpt);
+  REQUIRE(builds == 1);
+}
@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include "ChargeSD.h"
+#include "PetNESTStackingAction.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <cmath>
+
+
+TEST_CASE("ChargeSD wire positions and angles are consistent") {
+
+  ChargeSD sd("/TEST/ChargeSD");
+  const G4double radius  = 200. * mm;
+  const G4int    n_wires = 314;
+  sd.SetWireRing(radius, n_wires);
+
+  REQUIRE(sd.GetNumberOfWires() == n_wires);
+  REQUIRE(sd.GetWireRadius()    == radius);
+
+  // The first wire is along +y
+  REQUIRE(sd.GetWirePosition(0).x() == Approx(0.).margin(1.e-9));
+  REQUIRE(sd.GetWirePosition(0).y() == Approx(radius));
+
+  const G4double step = twopi / n_wires;
+  for (G4int i=0; i<n_wires; i++) {
+    G4ThreeVector pos = sd.GetWirePosition(i);
+    REQUIRE(pos.perp() == Approx(radius));
+    REQUIRE(pos.z()    == 0.);
+
+    G4double phi = std::atan2(-pos.x(), pos.y());
+    REQUIRE(sd.FindWire(phi) == i);
+    // Anything closer to this wire than to its neighbours
+    REQUIRE(sd.FindWire(phi + 0.49 * step) == i);
+    REQUIRE(sd.FindWire(phi - 0.49 * step) == i);
+  }
+
+  // Angles beyond a full turn, in either direction
+  REQUIRE(sd.FindWire(-step) == n_wires - 1);
+  REQUIRE(sd.FindWire(twopi + step) == 1);
+}
+
+
+TEST_CASE("Parametric drift reaches the wire above the electron") {
+
+  ChargeSD sd("/TEST/ChargeSD_drift");
+  const G4double radius  = 200. * mm;
+  const G4int    n_wires = 314;
+  sd.SetWireRing(radius, n_wires);
+
+  const G4double velocity = 1.7 * mm/microsecond;
+
+  for (G4int k : {0, 1, 78, 157, 313}) {
+    G4ThreeVector wire = sd.GetWirePosition(k);
+
+    // Electrons below and above the wire ring, at any z
+    for (G4double r : {170. * mm, 230. * mm}) {
+      G4ThreeVector pos = wire * (r / radius);
+      pos.setZ(25. * mm);
+
+      G4double phi, time;
+      PetNESTStackingAction::DriftToWires(pos, radius, velocity, phi, time);
+
+      REQUIRE(sd.FindWire(phi) == k);
+      REQUIRE(time == Approx(std::abs(radius - r) / velocity));
+    }
+  }
+
+  // An electron created on the wires arrives at once
+  G4double phi, time;
+  PetNESTStackingAction::DriftToWires(sd.GetWirePosition(5), radius, velocity,
+                                      phi, time);
+  REQUIRE(time == Approx(0.).margin(1.e-9));
+  REQUIRE(sd.FindWire(phi) == 5);
+}
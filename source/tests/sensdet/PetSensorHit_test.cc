@@ -0,0 +1,56 @@
+#include <catch.hpp>
+
+#include "PetSensorHit.h"
+
+#include <G4SystemOfUnits.hh>
+
+#include <thread>
+
+
+TEST_CASE("PetSensorHit allocator is created with the first hit") {
+
+  PetSensorHit* hit = new PetSensorHit(1000, G4ThreeVector(1., 2., 3.));
+  REQUIRE(PetSensorHitAllocator != nullptr);
+
+  hit->AddPhoton(1.*ns, 7);
+  hit->AddPhoton(2.*ns, 8);
+  REQUIRE(hit->GetSnsID() == 1000);
+  REQUIRE(hit->GetPhotonMap().size() == 2);
+
+  G4Allocator<PetSensorHit>* allocator = PetSensorHitAllocator;
+  delete hit;
+
+  // Freed memory is reused by the same allocator
+  hit = new PetSensorHit();
+  REQUIRE(PetSensorHitAllocator == allocator);
+  delete hit;
+}
+
+
+TEST_CASE("PetSensorHit allocator is private to each thread") {
+
+  PetSensorHit* hit = new PetSensorHit();
+  G4Allocator<PetSensorHit>* main_allocator = PetSensorHitAllocator;
+
+  G4Allocator<PetSensorHit>* before = main_allocator;
+  G4Allocator<PetSensorHit>* after  = nullptr;
+  G4int id = -1;
+
+  std::thread worker([&]() {
+    before = PetSensorHitAllocator;
+    PetSensorHit* other = new PetSensorHit(5, G4ThreeVector());
+    after = PetSensorHitAllocator;
+    id = other->GetSnsID();
+    delete other;
+  });
+  worker.join();
+
+  REQUIRE(before == nullptr);
+  REQUIRE(after  != nullptr);
+  REQUIRE(after  != main_allocator);
+  REQUIRE(id == 5);
+
+  // The allocator of this thread is untouched
+  REQUIRE(PetSensorHitAllocator == main_allocator);
+  delete hit;
+}
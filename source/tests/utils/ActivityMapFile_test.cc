@@ -0,0 +1,163 @@
+#include <catch.hpp>
+
+#include "ActivityMapFile.h"
+#include "VoxelPointSampler.h"
+
+#include <G4StateManager.hh>
+#include <G4VExceptionHandler.hh>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+  // Turns the fatal exceptions of Geant4 into C++ exceptions,
+  // so that the rejection of wrong files can be checked
+  class ThrowingHandler : public G4VExceptionHandler
+  {
+  public:
+    G4bool Notify(const char*, const char*, G4ExceptionSeverity severity,
+                  const char* description) override
+    {
+      if (severity == JustWarning) return false;
+      throw std::runtime_error(description);
+    }
+  };
+
+  const G4int nx = 3, ny = 2, nz = 4;
+  const float lengths[3] = {30.f, 20.f, 80.f};
+
+  // Point file in the legacy format: number of voxels, lengths
+  // and cumulative distribution of the activity of all the voxels
+  std::vector<float> WriteLegacy(const std::string& filename)
+  {
+    std::vector<float> activity(nx * ny * nz, 0.f);
+    for (size_t i=0; i<activity.size(); i++)
+      if (i % 5 != 0) activity[i] = 1.f + i % 4;
+    float total = 0.f;
+    for (float a: activity) total += a;
+
+    std::vector<float> cdf(activity.size());
+    float sum = 0.f;
+    for (size_t i=0; i<activity.size(); i++) {
+      cdf[i] = sum / total;
+      sum += activity[i];
+    }
+
+    std::ofstream os(filename, std::ofstream::binary);
+    const int32_t n[3] = {nx, ny, nz};
+    os.write(reinterpret_cast<const char*>(n), sizeof(n));
+    os.write(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+    os.write(reinterpret_cast<const char*>(cdf.data()), cdf.size() * sizeof(float));
+    return cdf;
+  }
+
+  std::string Convert(const std::string& input, const std::string& output)
+  {
+    const char* petalodir = std::getenv("PETALODIR");
+    REQUIRE(petalodir);
+    std::string command = std::string("python3 ") + petalodir +
+      "/scripts/convert_point_file.py " + input + " " + output + " > /dev/null";
+    REQUIRE(std::system(command.c_str()) == 0);
+    return output;
+  }
+
+  void CopyBytes(const std::string& input, const std::string& output,
+                 size_t n_bytes, const char* magic = 0)
+  {
+    std::ifstream is(input, std::ifstream::binary);
+    std::vector<char> data(n_bytes);
+    is.read(data.data(), n_bytes);
+    if (magic) std::copy(magic, magic + 8, data.begin());
+    std::ofstream os(output, std::ofstream::binary);
+    os.write(data.data(), is.gcount());
+  }
+
+}
+
+
+TEST_CASE("Point files converted to format v2 keep the activity of each voxel") {
+
+  const std::string legacy = "ActivityMapFile_test.bin";
+  const std::string v2     = "ActivityMapFile_test.v2";
+  std::vector<float> cdf = WriteLegacy(legacy);
+  Convert(legacy, v2);
+
+  REQUIRE( ActivityMapFile::IsVersion2(v2));
+  REQUIRE(!ActivityMapFile::IsVersion2(legacy));
+
+  ActivityMapFile file(v2);
+  REQUIRE(file.GetNx() == nx);
+  REQUIRE(file.GetNy() == ny);
+  REQUIRE(file.GetNz() == nz);
+  REQUIRE(file.GetLx() == lengths[0]);
+  REQUIRE(file.GetLy() == lengths[1]);
+  REQUIRE(file.GetLz() == lengths[2]);
+
+  // Probability of each voxel given by the alias tables
+  size_t n = file.GetNumberOfEntries();
+  std::vector<G4double> p_v2(nx * ny * nz, 0.);
+  for (size_t k=0; k<n; k++) {
+    p_v2[file.GetVoxels()[k]] += file.GetProbabilities()[k] / n;
+    p_v2[file.GetVoxels()[file.GetAliases()[k]]] +=
+      (1. - file.GetProbabilities()[k]) / n;
+  }
+
+  // and by the cumulative distribution, as read by the v1 path
+  VoxelPointSampler v1(nx, ny, nz, lengths[0], lengths[1], lengths[2]);
+  v1.SetCumulativeActivity(cdf);
+  REQUIRE(v1.GetNumberOfActiveVoxels() == n);
+
+  for (size_t i=0; i<cdf.size(); i++) {
+    G4double next = (i+1 < cdf.size()) ? (G4double)cdf[i+1] : 1.;
+    REQUIRE(p_v2[i] == Approx(next - (G4double)cdf[i]).margin(1.e-12));
+  }
+
+  std::remove(legacy.c_str());
+  std::remove(v2.c_str());
+}
+
+
+TEST_CASE("Truncated point files and files with a wrong magic are rejected") {
+
+  const std::string legacy = "ActivityMapFile_bad_test.bin";
+  const std::string v2     = "ActivityMapFile_bad_test.v2";
+  const std::string bad    = "ActivityMapFile_bad_test.bad";
+  WriteLegacy(legacy);
+  Convert(legacy, v2);
+
+  G4VExceptionHandler* previous =
+    G4StateManager::GetStateManager()->GetExceptionHandler();
+  ThrowingHandler handler;
+  G4StateManager::GetStateManager()->SetExceptionHandler(&handler);
+
+  REQUIRE_NOTHROW(ActivityMapFile(v2));
+
+  // Shorter than the header
+  CopyBytes(v2, bad, 40);
+  REQUIRE_THROWS(ActivityMapFile(bad));
+
+  // Shorter than the tables announced in the header
+  CopyBytes(v2, bad, 64 + 10);
+  REQUIRE_THROWS(ActivityMapFile(bad));
+
+  // Wrong magic string
+  CopyBytes(v2, bad, 1 << 20, "PETPTV1");
+  REQUIRE(!ActivityMapFile::IsVersion2(bad));
+  REQUIRE_THROWS(ActivityMapFile(bad));
+
+  // Legacy files are not read as v2
+  REQUIRE_THROWS(ActivityMapFile(legacy));
+
+  G4StateManager::GetStateManager()->SetExceptionHandler(previous);
+
+  std::remove(legacy.c_str());
+  std::remove(v2.c_str());
+  std::remove(bad.c_str());
+}
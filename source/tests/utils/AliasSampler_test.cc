@@ -0,0 +1,78 @@
+#include <catch.hpp>
+
+#include "AliasSampler.h"
+
+#include <Randomize.hh>
+
+#include <numeric>
+#include <vector>
+
+
+TEST_CASE("AliasSampler tables reproduce the weights exactly") {
+
+  const std::vector<G4double> weights = {1., 0., 2.5, 3., 0., 10., 0.5};
+  AliasSampler sampler(weights);
+
+  REQUIRE(sampler.GetSize() == weights.size());
+  REQUIRE(sampler.GetTotalWeight() == Approx(17.));
+
+  // The probability of each entry is the area of the unit square of
+  // (u1, u2) that maps to it. It is integrated on a grid, which is exact
+  // up to the size of a cell.
+  const G4int n = 2000;
+  std::vector<G4double> area(weights.size(), 0.);
+  for (G4int i=0; i<n; i++)
+    for (G4int j=0; j<n; j++)
+      area[sampler.Sample((i + 0.5) / n, (j + 0.5) / n)] += 1. / n / n;
+
+  for (size_t k=0; k<weights.size(); k++)
+    REQUIRE(area[k] == Approx(weights[k] / 17.).margin(2. / n));
+}
+
+
+TEST_CASE("AliasSampler frequencies pass a chi-square test") {
+
+  const std::vector<G4double> weights = {1., 2., 3., 4., 10., 0., 30.};
+  AliasSampler sampler(weights);
+  G4double total = std::accumulate(weights.begin(), weights.end(), 0.);
+
+  G4Random::setTheSeed(16062020);
+  const G4int n_samples = 200000;
+  std::vector<G4int> counts(weights.size(), 0);
+  for (G4int i=0; i<n_samples; i++)
+    counts[sampler.Sample()]++;
+
+  G4double chi2 = 0.;
+  G4int dof = -1;
+  for (size_t k=0; k<weights.size(); k++) {
+    if (weights[k] == 0.) continue;
+    G4double expected = n_samples * weights[k] / total;
+    chi2 += (counts[k] - expected) * (counts[k] - expected) / expected;
+    dof++;
+  }
+
+  // 99.9% quantile of the chi-square distribution with 5 degrees of freedom
+  REQUIRE(dof == 5);
+  REQUIRE(chi2 < 20.52);
+}
+
+
+TEST_CASE("AliasSampler never returns entries with zero weight") {
+
+  std::vector<G4double> weights(1000, 0.);
+  weights[3] = 1.;
+  weights[500] = 1.e-6;
+  weights[999] = 2.;
+  AliasSampler sampler(weights);
+
+  G4Random::setTheSeed(1);
+  for (G4int i=0; i<100000; i++) {
+    size_t k = sampler.Sample();
+    REQUIRE(weights[k] > 0.);
+  }
+
+  // Also at the edges of the unit square
+  for (G4double u1 : {0., 0.5, 0.999999999})
+    for (G4double u2 : {0., 0.5, 0.999999999})
+      REQUIRE(weights[sampler.Sample(u1, u2)] > 0.);
+}
@@ -0,0 +1,55 @@
+#include <catch.hpp>
+
+#include "EventSeeder.h"
+
+#include <Randomize.hh>
+
+#include <set>
+#include <vector>
+
+
+TEST_CASE("EventSeeder seeds depend only on run seed and event id") {
+
+  long s1[4], s2[4];
+  EventSeeder::EventSeeds(16062020, 12345, s1, 4);
+  EventSeeder::EventSeeds(16062020, 12345, s2, 4);
+  for (G4int i=0; i<4; i++) {
+    REQUIRE(s1[i] == s2[i]);
+    REQUIRE(s1[i] > 0);
+  }
+
+  // Neighbouring events and runs get different streams
+  std::set<long> first_seeds;
+  for (std::uint64_t run=0; run<10; run++)
+    for (std::uint64_t evt=0; evt<1000; evt++) {
+      long s[4];
+      EventSeeder::EventSeeds(run, evt, s, 4);
+      first_seeds.insert(s[0]);
+    }
+  REQUIRE(first_seeds.size() == 10000);
+}
+
+
+TEST_CASE("EventSeeder streams are reproducible in isolation") {
+
+  const G4int n = 100;
+
+  auto draw = [n](std::uint64_t evt) {
+    long seeds[5];
+    EventSeeder::EventSeeds(1, evt, seeds, 4);
+    seeds[4] = 0;
+    G4Random::getTheEngine()->setSeeds(seeds, 4);
+    std::vector<G4double> v(n);
+    G4Random::getTheEngine()->flatArray(n, v.data());
+    return v;
+  };
+
+  // Event 7 simulated after events 0-6 or on its own
+  for (std::uint64_t evt=0; evt<7; evt++) draw(evt);
+  auto in_sequence = draw(7);
+  G4UniformRand();
+  auto isolated = draw(7);
+
+  REQUIRE(in_sequence == isolated);
+  REQUIRE(draw(8) != isolated);
+}
@@ -0,0 +1,95 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch.hpp>
+
+#include "PrimaryVertexBuilder.h"
+
+#include <G4Gamma.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4ParticleTable.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4PrimaryParticle.hh>
+#include <G4RandomDirection.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <vector>
+
+
+TEST_CASE("PrimaryVertexBuilder isotropic primaries") {
+
+  PrimaryVertexBuilder builder(G4OpticalPhoton::Definition());
+
+  std::vector<G4double> energies;
+  for (G4int i=0; i<1000; i++)
+    energies.push_back((7. + i * 0.001) * eV);
+
+  G4PrimaryVertex vertex(G4ThreeVector(), 0.);
+  builder.AddIsotropic(&vertex, energies, true);
+
+  REQUIRE(vertex.GetNumberOfParticle() == 1000);
+
+  G4ThreeVector sum;
+  for (G4int i=0; i<vertex.GetNumberOfParticle(); i++) {
+    G4PrimaryParticle* p = vertex.GetPrimary(i);
+    REQUIRE(p->GetParticleDefinition() == G4OpticalPhoton::Definition());
+    REQUIRE(p->GetTotalMomentum() == Approx(energies[i]));
+    REQUIRE(p->GetPolarization().mag() == Approx(1.));
+    sum += p->GetMomentumDirection();
+  }
+
+  // Isotropic directions average to zero
+  REQUIRE(sum.mag() / 1000 < 0.1);
+}
+
+
+TEST_CASE("PrimaryVertexBuilder back-to-back primaries") {
+
+  PrimaryVertexBuilder builder(G4Gamma::Definition());
+
+  G4PrimaryVertex vertex(G4ThreeVector(), 0.);
+  builder.AddBackToBack(&vertex, 5, 510.999*keV);
+
+  REQUIRE(vertex.GetNumberOfParticle() == 10);
+
+  for (G4int i=0; i<5; i++) {
+    G4PrimaryParticle* p1 = vertex.GetPrimary(2*i);
+    G4PrimaryParticle* p2 = vertex.GetPrimary(2*i+1);
+    REQUIRE(p1->GetKineticEnergy() == Approx(510.999*keV));
+    REQUIRE(p2->GetKineticEnergy() == Approx(510.999*keV));
+    REQUIRE((p1->GetMomentum() + p2->GetMomentum()).mag() ==
+            Approx(0.).margin(1.e-9));
+  }
+}
+
+
+TEST_CASE("PrimaryVertexBuilder benchmark", "[.][benchmark]") {
+
+  // Vertex of 100k scintillation photons, as in LXeScintillationGenerator
+  const G4int n_photons = 100000;
+  std::vector<G4double> energies(n_photons, 7. * eV);
+
+  BENCHMARK("one particle at a time") {
+    G4ParticleDefinition* particle =
+      G4ParticleTable::GetParticleTable()->FindParticle("opticalphoton");
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(G4ThreeVector(), 0.);
+    for (G4int i=0; i<n_photons; i++) {
+      G4ThreeVector p = energies[i] * G4RandomDirection();
+      G4PrimaryParticle* primary =
+        new G4PrimaryParticle(particle, p.x(), p.y(), p.z());
+      primary->SetPolarization(G4RandomDirection());
+      vertex->SetPrimary(primary);
+    }
+    G4int n = vertex->GetNumberOfParticle();
+    delete vertex;
+    return n;
+  };
+
+  PrimaryVertexBuilder builder(G4OpticalPhoton::Definition());
+
+  BENCHMARK("PrimaryVertexBuilder") {
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(G4ThreeVector(), 0.);
+    builder.AddIsotropic(vertex, energies, true);
+    G4int n = vertex->GetNumberOfParticle();
+    delete vertex;
+    return n;
+  };
+}
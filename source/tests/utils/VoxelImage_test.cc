@@ -0,0 +1,179 @@
+#include <catch.hpp>
+
+#include "VoxelImage.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4StateManager.hh>
+#include <G4VExceptionHandler.hh>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+  // Turns the fatal exceptions of Geant4 into C++ exceptions,
+  // so that the rejection of wrong images can be checked
+  class ThrowingHandler : public G4VExceptionHandler
+  {
+  public:
+    G4bool Notify(const char*, const char*, G4ExceptionSeverity severity,
+                  const char* description) override
+    {
+      if (severity == JustWarning) return false;
+      throw std::runtime_error(description);
+    }
+  };
+
+  const G4int nx = 3, ny = 4, nz = 2;
+
+  // Value of voxel (ix, iy, iz), different for every voxel
+  G4float Value(G4int ix, G4int iy, G4int iz)
+  { return 100. * iz + 10. * iy + ix; }
+
+  std::vector<G4float> Values()
+  {
+    std::vector<G4float> v;
+    for (G4int iz=0; iz<nz; iz++)
+      for (G4int iy=0; iy<ny; iy++)
+        for (G4int ix=0; ix<nx; ix++)
+          v.push_back(Value(ix, iy, iz));
+    return v;
+  }
+
+  // Single-file NIfTI-1 image: 348-byte header, 4-byte extension
+  // flag and the values, x running fastest
+  template <typename T>
+  void WriteNIfTI(const std::string& filename, int16_t datatype,
+                  float slope, float inter)
+  {
+    char hdr[348] = {};
+    int32_t sizeof_hdr = 348;
+    int16_t dim[8] = {3, nx, ny, nz, 1, 1, 1, 1};
+    int16_t bitpix = 8 * sizeof(T);
+    float pixdim[8] = {1.f, 2.f, 2.5f, 4.f, 0.f, 0.f, 0.f, 0.f};
+    float vox_offset = 352.f;
+
+    std::memcpy(hdr +   0, &sizeof_hdr, 4);
+    std::memcpy(hdr +  40, dim, 16);
+    std::memcpy(hdr +  70, &datatype, 2);
+    std::memcpy(hdr +  72, &bitpix, 2);
+    std::memcpy(hdr +  76, pixdim, 32);
+    std::memcpy(hdr + 108, &vox_offset, 4);
+    std::memcpy(hdr + 112, &slope, 4);
+    std::memcpy(hdr + 116, &inter, 4);
+    std::memcpy(hdr + 344, "n+1", 4);
+
+    std::ofstream os(filename, std::ofstream::binary);
+    os.write(hdr, sizeof(hdr));
+    const char extension[4] = {};
+    os.write(extension, 4);
+    for (G4float v: Values()) {
+      T stored = static_cast<T>((v - inter) / (slope != 0.f ? slope : 1.f));
+      os.write(reinterpret_cast<const char*>(&stored), sizeof(T));
+    }
+  }
+
+}
+
+
+TEST_CASE("VoxelImage reads float NIfTI images") {
+
+  const std::string filename = "VoxelImage_test.nii";
+  WriteNIfTI<float>(filename, 16, 0.f, 0.f);
+
+  VoxelImage image;
+  image.Read(filename);
+
+  REQUIRE(image.GetNx() == nx);
+  REQUIRE(image.GetNy() == ny);
+  REQUIRE(image.GetNz() == nz);
+  REQUIRE(image.GetVoxelSize().x() == Approx(2.0 * mm));
+  REQUIRE(image.GetVoxelSize().y() == Approx(2.5 * mm));
+  REQUIRE(image.GetVoxelSize().z() == Approx(4.0 * mm));
+  REQUIRE(image.GetData() == Values());
+
+  image.Clear();
+  REQUIRE(image.GetData().empty());
+
+  std::remove(filename.c_str());
+}
+
+
+TEST_CASE("VoxelImage applies the scaling of integer NIfTI images") {
+
+  const std::string filename = "VoxelImage_scaled_test.nii";
+  WriteNIfTI<int16_t>(filename, 4, 0.5f, -2.f);
+
+  VoxelImage image;
+  image.Read(filename);
+
+  REQUIRE(image.GetData().size() == (size_t)(nx * ny * nz));
+  for (G4int iz=0; iz<nz; iz++)
+    for (G4int iy=0; iy<ny; iy++)
+      for (G4int ix=0; ix<nx; ix++)
+        REQUIRE(image.GetData()[ix + nx * (iy + ny * iz)] ==
+                Approx(Value(ix, iy, iz)));
+
+  std::remove(filename.c_str());
+}
+
+
+TEST_CASE("VoxelImage reads raw float32 images") {
+
+  const std::string filename = "VoxelImage_test.raw";
+  std::vector<G4float> values = Values();
+  {
+    std::ofstream os(filename, std::ofstream::binary);
+    os.write(reinterpret_cast<const char*>(values.data()),
+             values.size() * sizeof(G4float));
+  }
+
+  VoxelImage image;
+  image.Read(filename, nx, ny, nz, G4ThreeVector(1.*mm, 2.*mm, 3.*mm));
+
+  REQUIRE(image.GetNx() == nx);
+  REQUIRE(image.GetNy() == ny);
+  REQUIRE(image.GetNz() == nz);
+  REQUIRE(image.GetVoxelSize().x() == 1.*mm);
+  REQUIRE(image.GetVoxelSize().y() == 2.*mm);
+  REQUIRE(image.GetVoxelSize().z() == 3.*mm);
+  REQUIRE(image.GetData() == values);
+
+  std::remove(filename.c_str());
+}
+
+
+TEST_CASE("VoxelImage rejects non-finite values") {
+
+  const std::string filename = "VoxelImage_nan_test.raw";
+
+  G4VExceptionHandler* previous =
+    G4StateManager::GetStateManager()->GetExceptionHandler();
+  ThrowingHandler handler;
+  G4StateManager::GetStateManager()->SetExceptionHandler(&handler);
+
+  for (G4float bad: {std::numeric_limits<G4float>::quiet_NaN(),
+                     std::numeric_limits<G4float>::infinity()}) {
+    std::vector<G4float> values = Values();
+    values[5] = bad;
+    {
+      std::ofstream os(filename, std::ofstream::binary);
+      os.write(reinterpret_cast<const char*>(values.data()),
+               values.size() * sizeof(G4float));
+    }
+
+    VoxelImage image;
+    REQUIRE_THROWS(image.Read(filename, nx, ny, nz,
+                              G4ThreeVector(1.*mm, 1.*mm, 1.*mm)));
+  }
+
+  G4StateManager::GetStateManager()->SetExceptionHandler(previous);
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,107 @@
+#include <catch.hpp>
+
+#include "VoxelPointSampler.h"
+
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  // Index of the voxel containing a point, as in VoxelPointSampler
+  G4int VoxelOf(const G4ThreeVector& p, G4int nx, G4int ny, G4int nz,
+                G4double lx, G4double ly, G4double lz)
+  {
+    G4int ix = std::floor((p.x() / lx + 0.5) * nx);
+    G4int iy = std::floor((p.y() / ly + 0.5) * ny);
+    G4int iz = std::floor((p.z() / lz + 0.5) * nz);
+    return (ix * ny + iy) * nz + iz;
+  }
+
+}
+
+
+TEST_CASE("VoxelPointSampler never samples voxels without activity") {
+
+  const G4int nx = 4, ny = 5, nz = 6;
+  const G4double lx = 40.*mm, ly = 50.*mm, lz = 120.*mm;
+  VoxelPointSampler sampler(nx, ny, nz, lx, ly, lz);
+
+  std::vector<G4double> activity(nx * ny * nz, 0.);
+  for (size_t i=0; i<activity.size(); i+=7) activity[i] = 1. + i % 3;
+  sampler.SetActivity(activity);
+
+  G4Random::setTheSeed(16062020);
+  std::vector<G4int> counts(activity.size(), 0);
+  for (G4int i=0; i<100000; i++) {
+    G4ThreeVector p = sampler.GenerateVertex();
+    G4int v = VoxelOf(p, nx, ny, nz, lx, ly, lz);
+    REQUIRE(v >= 0);
+    REQUIRE(v < nx * ny * nz);
+    counts[v]++;
+  }
+
+  for (size_t i=0; i<activity.size(); i++) {
+    if (activity[i] == 0.) REQUIRE(counts[i] == 0);
+    else                   REQUIRE(counts[i] > 0);
+  }
+}
+
+
+TEST_CASE("VoxelPointSampler cumulative maps skip empty voxels") {
+
+  VoxelPointSampler sampler(2, 2, 2, 20.*mm, 20.*mm, 20.*mm);
+
+  // Voxels 1, 2 and 6 have no activity
+  std::vector<G4float> cdf = {0.f, .2f, .2f, .2f, .5f, .6f, .9f, .9f};
+  sampler.SetCumulativeActivity(cdf);
+  REQUIRE(sampler.GetNumberOfActiveVoxels() == 5);
+
+  G4Random::setTheSeed(1);
+  for (G4int i=0; i<20000; i++) {
+    G4int v = VoxelOf(sampler.GenerateVertex(), 2, 2, 2, 20.*mm, 20.*mm, 20.*mm);
+    REQUIRE(v != 1);
+    REQUIRE(v != 2);
+    REQUIRE(v != 6);
+  }
+}
+
+
+TEST_CASE("VoxelPointSampler points fill the voxel and stay inside it") {
+
+  const G4int nx = 3, ny = 3, nz = 3;
+  const G4double lx = 30.*mm, ly = 60.*mm, lz = 90.*mm;
+  VoxelPointSampler sampler(nx, ny, nz, lx, ly, lz);
+
+  // Only the voxel (2, 0, 1) is active
+  const unsigned int voxel = (2 * ny + 0) * nz + 1;
+  sampler.SetActivity({voxel}, {1.});
+
+  G4ThreeVector centre = sampler.GetVoxelCentre(voxel);
+  REQUIRE(centre.x() == Approx( 10.*mm));
+  REQUIRE(centre.y() == Approx(-20.*mm));
+  REQUIRE(centre.z() == Approx(  0.*mm));
+
+  const G4double half[3] = {lx / nx / 2., ly / ny / 2., lz / nz / 2.};
+  G4double min[3] = { 1.e9,  1.e9,  1.e9};
+  G4double max[3] = {-1.e9, -1.e9, -1.e9};
+
+  G4Random::setTheSeed(16062020);
+  for (G4int i=0; i<10000; i++) {
+    G4ThreeVector d = sampler.GenerateVertex() - centre;
+    for (G4int k=0; k<3; k++) {
+      REQUIRE(std::abs(d[k]) <= half[k]);
+      min[k] = std::min(min[k], d[k]);
+      max[k] = std::max(max[k], d[k]);
+    }
+  }
+
+  // The whole voxel is covered
+  for (G4int k=0; k<3; k++) {
+    REQUIRE(min[k] < -0.99 * half[k]);
+    REQUIRE(max[k] >  0.99 * half[k]);
+  }
+}
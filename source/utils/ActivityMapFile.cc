@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// petalosim | ActivityMapFile.cc
+//
+// Read-only, memory-mapped access to an activity map stored in the
+// point-file format v2. See the header file for the description
+// of the format.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ActivityMapFile.h"
+
+#include <G4Exception.hh>
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  const char magic_v2[8] = "PETPTV2";
+  const size_t header_size = 64;
+}
+
+ActivityMapFile::ActivityMapFile(const G4String& filename):
+  data_(0), size_(0), header_(0)
+{
+  static_assert(sizeof(Header) == header_size,
+                "Wrong size of point-file header");
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                ("Cannot open point file " + filename).c_str());
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                ("Cannot get the size of point file " + filename).c_str());
+  }
+  size_ = st.st_size;
+  if (size_ < header_size)
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                "Point file shorter than its header.");
+
+  // Read-only, shared mapping: the pages are shared by all the processes
+  // mapping the same file
+  data_ = mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED)
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                ("Cannot map point file " + filename).c_str());
+
+  header_ = static_cast<const Header*>(data_);
+
+  if (std::memcmp(header_->magic, magic_v2, sizeof(magic_v2)) != 0 ||
+      header_->version != 2)
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                "Point file is not in format v2.");
+
+  uint64_t n = header_->n_entries;
+  uint64_t n_voxels = (uint64_t)header_->n[0] * header_->n[1] * header_->n[2];
+  if (n == 0 || n > n_voxels || size_ < header_size + 16 * n)
+    G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                "Point file inconsistent with its header.");
+
+  const unsigned int* alias = GetAliases();
+  const unsigned int* voxels = GetVoxels();
+  for (uint64_t i=0; i<n; i++) {
+    if (alias[i] >= n || voxels[i] >= n_voxels)
+      G4Exception("[ActivityMapFile]", "ActivityMapFile()", FatalException,
+                  "Index out of range in point file.");
+  }
+}
+
+
+
+ActivityMapFile::~ActivityMapFile()
+{
+  if (data_ && data_ != MAP_FAILED)
+    munmap(data_, size_);
+}
+
+
+
+G4bool ActivityMapFile::IsVersion2(const G4String& filename)
+{
+  char magic[8] = {};
+  std::ifstream is(filename, std::ifstream::binary);
+  is.read(magic, sizeof(magic));
+  return is.good() && std::memcmp(magic, magic_v2, sizeof(magic_v2)) == 0;
+}
+
+
+
+const G4double* ActivityMapFile::GetProbabilities() const
+{
+  return reinterpret_cast<const G4double*>
+    (static_cast<const char*>(data_) + header_size);
+}
+
+
+
+const unsigned int* ActivityMapFile::GetAliases() const
+{
+  return reinterpret_cast<const unsigned int*>
+    (static_cast<const char*>(data_) + header_size + 8 * header_->n_entries);
+}
+
+
+
+const unsigned int* ActivityMapFile::GetVoxels() const
+{
+  return reinterpret_cast<const unsigned int*>
+    (static_cast<const char*>(data_) + header_size + 12 * header_->n_entries);
+}
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// petalosim | ActivityMapFile.h
+//
+// Read-only, memory-mapped access to an activity map stored in the
+// point-file format v2. Since the mapping is shared, all the jobs running
+// on the same node with the same file use a single copy of it in memory.
+//
+// Format v2 (little endian). The header has 64 bytes:
+//
+//   offset  type        content
+//   0       char[8]     magic "PETPTV2", null terminated
+//   8       uint32      format version (2)
+//   12      uint32      flags (reserved, 0)
+//   16      int32[3]    number of voxels along x, y, z
+//   28      uint32      padding
+//   32      float64[3]  total length of the grid along x, y, z (mm)
+//   56      uint64      number n of voxels with activity
+//
+// followed by three arrays of n entries, with one entry per voxel with
+// activity (voxels without activity are not stored):
+//
+//   64              float64[n]  alias table: probability of keeping the entry
+//   64 + 8n         uint32[n]   alias table: entry taken otherwise
+//   64 + 12n        uint32[n]   voxel index, (ix * ny + iy) * nz + iz
+//
+// The alias tables are built by scripts/convert_point_file.py, so they are
+// not computed when the file is read. The constructor only scans the
+// entries once to check that their indices are in range.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ACTIVITY_MAP_FILE_H
+#define ACTIVITY_MAP_FILE_H
+
+#include <G4String.hh>
+#include <cstdint>
+
+class ActivityMapFile
+{
+public:
+  /// Constructor: the file is opened and mapped
+  ActivityMapFile(const G4String& filename);
+  /// Destructor: the file is unmapped
+  ~ActivityMapFile();
+
+  /// Return true if the file starts with the magic string of the format v2
+  static G4bool IsVersion2(const G4String& filename);
+
+  G4int GetNx() const;
+  G4int GetNy() const;
+  G4int GetNz() const;
+  G4double GetLx() const;
+  G4double GetLy() const;
+  G4double GetLz() const;
+
+  /// Number of voxels with activity
+  size_t GetNumberOfEntries() const;
+  const G4double* GetProbabilities() const;
+  const unsigned int* GetAliases() const;
+  const unsigned int* GetVoxels() const;
+
+private:
+  struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    int32_t  n[3];
+    uint32_t padding;
+    double   length[3];
+    uint64_t n_entries;
+  };
+
+  void* data_;    ///< start of the mapping
+  size_t size_;   ///< size of the mapping in bytes
+  const Header* header_;
+};
+
+inline G4int ActivityMapFile::GetNx() const { return header_->n[0]; }
+inline G4int ActivityMapFile::GetNy() const { return header_->n[1]; }
+inline G4int ActivityMapFile::GetNz() const { return header_->n[2]; }
+inline G4double ActivityMapFile::GetLx() const { return header_->length[0]; }
+inline G4double ActivityMapFile::GetLy() const { return header_->length[1]; }
+inline G4double ActivityMapFile::GetLz() const { return header_->length[2]; }
+inline size_t ActivityMapFile::GetNumberOfEntries() const
+{ return header_->n_entries; }
+
+#endif
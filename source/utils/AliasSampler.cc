@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// petalosim | AliasSampler.cc
+//
+// Sampler of a discrete probability distribution with the alias method
+// of Walker (in the formulation of Vose). The tables are built once,
+// in double precision, in a time proportional to the number of entries,
+// and each sample costs two random numbers, whatever the number of entries.
+// The tables can also be taken from external memory (e.g., a mapped file).
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "AliasSampler.h"
+
+#include <G4Exception.hh>
+#include <Randomize.hh>
+
+AliasSampler::AliasSampler():
+  total_(0.), n_(0), prob_ptr_(0), alias_ptr_(0)
+{
+}
+
+
+
+AliasSampler::AliasSampler(const std::vector<G4double>& weights):
+  total_(0.), n_(0), prob_ptr_(0), alias_ptr_(0)
+{
+  SetWeights(weights);
+}
+
+
+
+AliasSampler::~AliasSampler()
+{
+}
+
+
+
+void AliasSampler::SetWeights(const std::vector<G4double>& weights)
+{
+  size_t n = weights.size();
+  prob_.assign(n, 0.);
+  alias_.assign(n, 0);
+
+  total_ = 0.;
+  for (size_t i=0; i<n; i++) {
+    if (weights[i] < 0.)
+      G4Exception("[AliasSampler]", "SetWeights()", FatalErrorInArgument,
+                  "Negative weight in distribution.");
+    total_ += weights[i];
+  }
+
+  if (n == 0 || total_ <= 0.)
+    G4Exception("[AliasSampler]", "SetWeights()", FatalErrorInArgument,
+                "Empty distribution.");
+
+  // Each entry gets a probability scaled so that the mean is one.
+  // Entries below one are completed with the excess of an entry above one.
+  std::vector<unsigned int> small, large;
+  small.reserve(n);
+  large.reserve(n);
+  for (size_t i=0; i<n; i++) {
+    prob_[i] = weights[i] * n / total_;
+    if (prob_[i] < 1.) small.push_back(i);
+    else large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    unsigned int s = small.back(); small.pop_back();
+    unsigned int l = large.back();
+    alias_[s] = l;
+    prob_[l] = (prob_[l] + prob_[s]) - 1.;
+    if (prob_[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // Entries left are one up to rounding errors
+  for (size_t i=0; i<large.size(); i++) {
+    prob_[large[i]] = 1.;
+    alias_[large[i]] = large[i];
+  }
+  for (size_t i=0; i<small.size(); i++) {
+    prob_[small[i]] = 1.;
+    alias_[small[i]] = small[i];
+  }
+
+  n_ = n;
+  prob_ptr_ = prob_.data();
+  alias_ptr_ = alias_.data();
+}
+
+
+
+void AliasSampler::SetTables(size_t n, const G4double* prob,
+                             const unsigned int* alias)
+{
+  if (n == 0)
+    G4Exception("[AliasSampler]", "SetTables()", FatalErrorInArgument,
+                "Empty distribution.");
+
+  prob_.clear();
+  alias_.clear();
+  total_ = 1.;
+
+  n_ = n;
+  prob_ptr_ = prob;
+  alias_ptr_ = alias;
+}
+
+
+
+size_t AliasSampler::Sample() const
+{
+  G4double u1 = G4UniformRand();
+  G4double u2 = G4UniformRand();
+  return Sample(u1, u2);
+}
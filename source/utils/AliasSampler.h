@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// petalosim | AliasSampler.h
+//
+// Sampler of a discrete probability distribution with the alias method
+// of Walker (in the formulation of Vose). The tables are built once,
+// in double precision, in a time proportional to the number of entries,
+// and each sample costs two random numbers, whatever the number of entries.
+// The tables can also be taken from external memory (e.g., a mapped file).
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ALIAS_SAMPLER_H
+#define ALIAS_SAMPLER_H
+
+#include <G4Types.hh>
+#include <vector>
+
+class AliasSampler
+{
+public:
+  /// Constructor of an empty sampler
+  AliasSampler();
+  /// Constructor from non-normalized, non-negative weights
+  AliasSampler(const std::vector<G4double>& weights);
+  /// Destructor
+  ~AliasSampler();
+
+  /// Build the tables from non-normalized, non-negative weights
+  void SetWeights(const std::vector<G4double>& weights);
+  /// Use tables already built, owned by the caller, which must keep
+  /// them alive while the sampler is used
+  void SetTables(size_t n, const G4double* prob, const unsigned int* alias);
+
+  /// Return the index of a random entry, using the Geant4 engine
+  size_t Sample() const;
+  /// Return the index of an entry given two uniform random numbers in [0, 1)
+  size_t Sample(G4double u1, G4double u2) const;
+
+  /// Number of entries
+  size_t GetSize() const;
+  /// Sum of the weights used to build the tables (one for external tables)
+  G4double GetTotalWeight() const;
+
+private:
+  std::vector<G4double> prob_;  ///< probability of keeping each entry
+  std::vector<unsigned int> alias_; ///< entry taken otherwise
+  G4double total_;
+
+  // Tables used for sampling: either the ones above or external ones
+  size_t n_;
+  const G4double* prob_ptr_;
+  const unsigned int* alias_ptr_;
+};
+
+inline size_t AliasSampler::GetSize() const { return n_; }
+inline G4double AliasSampler::GetTotalWeight() const { return total_; }
+
+inline size_t AliasSampler::Sample(G4double u1, G4double u2) const
+{
+  size_t i = u1 * n_;
+  if (i >= n_) i = n_ - 1;
+  return (u2 < prob_ptr_[i]) ? i : alias_ptr_[i];
+}
+
+#endif
@@ -0,0 +1,176 @@
+// ----------------------------------------------------------------------------
+// petalosim | EventSeeder.cc
+//
+// Reseeds the random engine at the beginning of each event with seeds
+// derived from the pair (run seed, global event id).
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "EventSeeder.h"
+#include "PetaloPersistencyManager.h"
+
+#include <G4Event.hh>
+#include <G4Run.hh>
+#include <G4RunManager.hh>
+#include <G4GenericMessenger.hh>
+#include <G4VUserPrimaryGeneratorAction.hh>
+#include <G4AutoLock.hh>
+#include <Randomize.hh>
+#include <RandomGen.hh>
+
+namespace {
+  G4Mutex seedMutex = G4MUTEX_INITIALIZER;
+
+  // Seeds passed to the engine. The array is followed by a zero,
+  // since some engines read seeds until they find one.
+  const G4int n_seeds = 4;
+
+  // Primary generator action reseeding the engine before delegating
+  // to the one of the application, which it owns
+  class SeededPrimaryGeneration: public G4VUserPrimaryGeneratorAction
+  {
+  public:
+    SeededPrimaryGeneration(G4VUserPrimaryGeneratorAction* action):
+      G4VUserPrimaryGeneratorAction(), action_(action) {}
+    ~SeededPrimaryGeneration() { delete action_; }
+
+    void GeneratePrimaries(G4Event* event) override
+    {
+      EventSeeder::Instance().Reseed(event);
+      action_->GeneratePrimaries(event);
+    }
+
+  private:
+    G4VUserPrimaryGeneratorAction* action_;
+  };
+}
+
+
+
+EventSeeder& EventSeeder::Instance()
+{
+  static EventSeeder instance;
+  return instance;
+}
+
+
+
+EventSeeder::EventSeeder():
+  enabled_(false), seed_(-1), run_seed_(0), has_run_seed_(false),
+  engine_seed_(0), run_id_(-1), offset_(0), run_events_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/petalosim/random/",
+                                "Control commands of the random streams.");
+  msg_->DeclareProperty("per_event_seeding", enabled_,
+    "Reseed the engine at each event from the run seed and the global event id.");
+  msg_->DeclareMethod("seed", &EventSeeder::SetSeed,
+    "Run seed of the per-event streams. If negative, the seed of the engine "
+    "(/nexus/random_seed) is used. The NEST generator is reseeded too.");
+}
+
+
+
+EventSeeder::~EventSeeder()
+{
+  delete msg_;
+}
+
+
+
+void EventSeeder::SetSeed(G4int seed)
+{
+  G4AutoLock l(&seedMutex);
+  seed_ = seed;
+  has_run_seed_ = false;
+}
+
+
+
+std::uint64_t EventSeeder::SplitMix64(std::uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+
+
+void EventSeeder::EventSeeds(std::uint64_t run_seed, std::uint64_t event_id,
+                             long* seeds, G4int n)
+{
+  // The key of the stream depends on both numbers, and the seeds are
+  // consecutive values of the counter of that stream
+  std::uint64_t key = SplitMix64(SplitMix64(run_seed) ^ event_id);
+  for (G4int i=0; i<n; i++) {
+    // Engines take 32-bit seeds: keep 31 bits and avoid zero
+    std::uint64_t h = SplitMix64(key + i);
+    long s = static_cast<long>(h & 0x7fffffffULL);
+    seeds[i] = (s == 0) ? 1 : s;
+  }
+}
+
+
+
+void EventSeeder::WrapPrimaryGeneration()
+{
+  G4RunManager* rm = G4RunManager::GetRunManager();
+  G4VUserPrimaryGeneratorAction* action =
+    const_cast<G4VUserPrimaryGeneratorAction*>(rm->GetUserPrimaryGeneratorAction());
+  if (!action || dynamic_cast<SeededPrimaryGeneration*>(action)) return;
+
+  // The run manager deletes the wrapper, which deletes the action
+  rm->SetUserAction(new SeededPrimaryGeneration(action));
+}
+
+
+
+void EventSeeder::Reseed(const G4Event* event)
+{
+  if (!enabled_) return;
+
+  const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+  G4int run_id = run ? run->GetRunID() : 0;
+
+  G4AutoLock l(&seedMutex);
+
+  if (run_id != run_id_) {
+    // Event ids restart at every /run/beamOn: the events of the
+    // previous runs are counted so that each event has its own stream
+    offset_ += run_events_;
+    run_events_ = 0;
+    run_id_ = run_id;
+
+    // A seed set with /nexus/random_seed since the last reseeding
+    // replaces the engine seed in use
+    if (seed_ < 0 && has_run_seed_ && G4Random::getTheSeed() != engine_seed_)
+      has_run_seed_ = false;
+  }
+
+  if (!has_run_seed_) {
+    // Taken before the engine is reseeded by this seed
+    run_seed_ = (seed_ < 0) ?
+      static_cast<std::uint64_t>(G4Random::getTheSeed()) :
+      static_cast<std::uint64_t>(seed_);
+    has_run_seed_ = true;
+    G4cout << "Per-event seeding with run seed " << run_seed_ << G4endl;
+  }
+
+  G4int start_id = 0;
+  PetaloPersistencyManager* pm = dynamic_cast<PetaloPersistencyManager*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm) start_id = pm->GetStartID();
+
+  std::uint64_t id = static_cast<std::uint64_t>(event->GetEventID());
+  if (id + 1 > run_events_) run_events_ = id + 1;
+  std::uint64_t event_id = static_cast<std::uint64_t>(start_id) + offset_ + id;
+
+  // One more seed than the engine takes, for NEST
+  long seeds[n_seeds + 1];
+  EventSeeds(run_seed_, event_id, seeds, n_seeds + 1);
+  RandomGen::rndm()->SetSeed(static_cast<std::uint64_t>(seeds[n_seeds]));
+  seeds[n_seeds] = 0;
+  G4Random::getTheEngine()->setSeeds(seeds, n_seeds);
+  engine_seed_ = G4Random::getTheSeed();
+}
@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------------
+// petalosim | EventSeeder.h
+//
+// Reseeds the random engine at the beginning of each event with seeds
+// derived from the pair (run seed, global event id), where the global
+// event id is the start id of the job plus the number of events of the
+// previous runs of the process plus the Geant4 event id. The seeds
+// are obtained with a counter-based hash (SplitMix64), so the random
+// sequence of an event does not depend on the events simulated before it,
+// on the split of the run in jobs or on the number of threads. Any event
+// can therefore be simulated again in isolation. The NEST generator, which
+// does not draw from the Geant4 engine, is reseeded from the same stream.
+// The engine is reseeded by a primary generator action wrapping the one of
+// the application, so that it is done for any generator, petalosim's or
+// nexus's, before it draws any random number of the event.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef EVENT_SEEDER_H
+#define EVENT_SEEDER_H
+
+#include <G4Types.hh>
+#include <cstdint>
+
+class G4Event;
+class G4GenericMessenger;
+
+class EventSeeder
+{
+public:
+  /// Return the single instance of the class
+  static EventSeeder& Instance();
+
+  /// Reseed the engine of the current thread for the given event,
+  /// if per-event seeding is enabled
+  void Reseed(const G4Event* event);
+
+  /// Wrap the primary generator action of the run manager, so that
+  /// Reseed() is called before the primaries of each event are generated.
+  /// Called by petalo once the application has been created.
+  void WrapPrimaryGeneration();
+
+  /// Fill n engine seeds for the event with global id event_id
+  static void EventSeeds(std::uint64_t run_seed, std::uint64_t event_id,
+                         long* seeds, G4int n);
+
+  /// SplitMix64 finalizer
+  static std::uint64_t SplitMix64(std::uint64_t x);
+
+  G4bool IsEnabled() const;
+
+  /// Set the run seed of the per-event streams
+  void SetSeed(G4int seed);
+
+private:
+  EventSeeder();
+  ~EventSeeder();
+  EventSeeder(const EventSeeder&) = delete;
+  EventSeeder& operator=(const EventSeeder&) = delete;
+
+  G4GenericMessenger* msg_;
+  G4bool enabled_; ///< Reseed the engine at each event
+  G4int seed_;     ///< Run seed. If negative, the seed of the engine is used
+
+  std::uint64_t run_seed_;   ///< Run seed in use
+  G4bool has_run_seed_;      ///< Whether run_seed_ is up to date
+  long engine_seed_;         ///< Engine seed after the last reseeding
+  G4int run_id_;             ///< ID of the run of the last event
+  std::uint64_t offset_;     ///< Events of the previous runs
+  std::uint64_t run_events_; ///< Events of the current run
+};
+
+inline G4bool EventSeeder::IsEnabled() const { return enabled_; }
+
+#endif
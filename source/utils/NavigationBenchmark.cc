@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// petalosim | NavigationBenchmark.cc
+//
+// Shoots a fixed set of straight rays through the geometry and reports
+// the number of navigation steps per second.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "NavigationBenchmark.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4TransportationManager.hh>
+#include <G4GeometryManager.hh>
+#include <G4Navigator.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+
+
+NavigationBenchmark& NavigationBenchmark::Instance()
+{
+  static NavigationBenchmark instance;
+  return instance;
+}
+
+
+
+NavigationBenchmark::NavigationBenchmark():
+  origin_(0., 0., 0.), seed_(16062020), max_steps_(100000), pending_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/petalosim/navigation/",
+                                "Control commands of the navigation benchmark.");
+  msg_->DeclareMethod("benchmark", &NavigationBenchmark::Benchmark,
+    "Navigate the given number of rays through the geometry and report the steps/s.");
+  msg_->DeclarePropertyWithUnit("origin", "mm", origin_,
+                                "Starting point of the rays.");
+  msg_->DeclareProperty("seed", seed_, "Seed of the directions of the rays.");
+  msg_->DeclareProperty("max_steps", max_steps_,
+                        "Maximum number of steps of each ray.");
+}
+
+
+
+NavigationBenchmark::~NavigationBenchmark()
+{
+  delete msg_;
+}
+
+
+
+void NavigationBenchmark::Benchmark(G4int n_rays)
+{
+  if (n_rays <= 0) return;
+
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+  if (!world) {
+    G4cout << "Navigation benchmark of " << n_rays
+           << " rays delayed until the geometry is built." << G4endl;
+    pending_ = n_rays;
+    return;
+  }
+
+  // Build the smart voxels with the settings of each volume,
+  // as done at the beginning of the first run
+  if (!G4GeometryManager::IsGeometryClosed())
+    G4GeometryManager::GetInstance()->CloseGeometry(true);
+
+  G4double time;
+  G4long n_steps = Navigate(world, n_rays, time);
+
+  G4cout << "------------------------------------------------------------\n"
+         << " Navigation benchmark: " << n_rays << " rays from "
+         << origin_ / mm << " mm, " << n_steps << " steps in "
+         << time << " s\n"
+         << "   steps/s   = " << (time > 0. ? n_steps / time : 0.) << "\n"
+         << "   steps/ray = " << (G4double) n_steps / n_rays << "\n"
+         << " Logical volumes with most daughters:\n";
+
+  std::vector<G4LogicalVolume*> volumes(G4LogicalVolumeStore::GetInstance()->begin(),
+                                        G4LogicalVolumeStore::GetInstance()->end());
+  std::sort(volumes.begin(), volumes.end(),
+            [](const G4LogicalVolume* a, const G4LogicalVolume* b)
+            { return a->GetNoDaughters() > b->GetNoDaughters(); });
+  for (size_t i=0; i<std::min(volumes.size(), (size_t) 3); i++) {
+    if (volumes[i]->GetNoDaughters() == 0) break;
+    G4cout << "   " << volumes[i]->GetName()
+           << ": " << volumes[i]->GetNoDaughters() << " daughters, smartless "
+           << volumes[i]->GetSmartless() << ", optimisation "
+           << (volumes[i]->IsToOptimise() ? "on" : "off") << "\n";
+  }
+  G4cout << "------------------------------------------------------------"
+         << G4endl;
+}
+
+
+
+void NavigationBenchmark::RunPending()
+{
+  G4int n_rays = pending_;
+  pending_ = 0;
+  Benchmark(n_rays);
+}
+
+
+
+G4long NavigationBenchmark::Navigate(G4VPhysicalVolume* world, G4int n_rays,
+                                     G4double& time) const
+{
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  std::mt19937_64 rng(seed_);
+  std::uniform_real_distribution<G4double> uniform(0., 1.);
+
+  G4long n_steps = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  for (G4int r=0; r<n_rays; r++) {
+    G4double cos_theta = 2. * uniform(rng) - 1.;
+    G4double sin_theta = std::sqrt(1. - cos_theta * cos_theta);
+    G4double phi = twopi * uniform(rng);
+    G4ThreeVector dir(sin_theta * std::cos(phi), sin_theta * std::sin(phi),
+                      cos_theta);
+    G4ThreeVector pos = origin_;
+
+    // Stepping from boundary to boundary until the ray leaves the world
+    G4VPhysicalVolume* volume =
+      navigator.LocateGlobalPointAndSetup(pos, &dir, false, false);
+    for (G4int i=0; volume && i<max_steps_; i++) {
+      G4double safety;
+      G4double step = navigator.ComputeStep(pos, dir, kInfinity, safety);
+      if (step == kInfinity) break;
+      pos += step * dir;
+      navigator.SetGeometricallyLimitedStep();
+      volume = navigator.LocateGlobalPointAndSetup(pos, &dir, true);
+      n_steps++;
+    }
+  }
+
+  time = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+  return n_steps;
+}
@@ -0,0 +1,53 @@
+// ----------------------------------------------------------------------------
+// petalosim | NavigationBenchmark.h
+//
+// Shoots a fixed set of straight rays (as geantinos, without physics)
+// through the geometry with a dedicated G4Navigator and reports the number
+// of navigation steps per second, to tune the smartless and optimisation
+// settings of the mother volumes with many daughters. The rays start at a
+// given point with isotropic directions drawn from a private generator
+// with a fixed seed, so they do not depend on nor change the Geant4 engine.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef NAVIGATION_BENCHMARK_H
+#define NAVIGATION_BENCHMARK_H
+
+#include <G4ThreeVector.hh>
+
+class G4GenericMessenger;
+class G4VPhysicalVolume;
+
+class NavigationBenchmark
+{
+public:
+  /// Return the single instance of the class
+  static NavigationBenchmark& Instance();
+
+  /// Run the benchmark with n_rays rays. If the geometry has not been
+  /// built yet, it is run by RunPending() once it is.
+  void Benchmark(G4int n_rays);
+
+  /// Run the benchmark requested before the geometry was built, if any.
+  /// Called by petalo after the initialization of the application.
+  void RunPending();
+
+  /// Navigate n_rays rays through the given world volume and return
+  /// the total number of steps, and the time taken (in s) in time
+  G4long Navigate(G4VPhysicalVolume* world, G4int n_rays, G4double& time) const;
+
+private:
+  NavigationBenchmark();
+  ~NavigationBenchmark();
+  NavigationBenchmark(const NavigationBenchmark&) = delete;
+  NavigationBenchmark& operator=(const NavigationBenchmark&) = delete;
+
+  G4GenericMessenger* msg_;
+  G4ThreeVector origin_; ///< Starting point of the rays
+  G4int seed_;           ///< Seed of the directions of the rays
+  G4int max_steps_;      ///< Maximum number of steps of a ray
+  G4int pending_;        ///< Rays of a benchmark waiting for the geometry
+};
+
+#endif
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// petalosim | PhaseSpaceFile.cc
+//
+// Binary phase-space file, written by PetPhaseSpaceSteppingAction and read
+// by PhaseSpaceGenerator. See the header file for the description
+// of the format.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhaseSpaceFile.h"
+
+#include <G4Exception.hh>
+
+#include <cstring>
+
+namespace {
+  const char magic_v1[8] = "PETPSV1";
+  const uint32_t version = 1;
+  const size_t block_size = 65536; ///< records per block
+}
+
+static_assert(sizeof(PhaseSpaceRecord) == 48,
+              "Phase-space records must not have padding");
+
+
+
+PhaseSpaceFile::PhaseSpaceFile(): writing_(false), pos_(0), n_records_(0)
+{
+}
+
+
+
+PhaseSpaceFile::~PhaseSpaceFile()
+{
+  Close();
+}
+
+
+
+void PhaseSpaceFile::OpenForWriting(const G4String& filename)
+{
+  Close();
+
+  file_.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_.is_open())
+    G4Exception("[PhaseSpaceFile]", "OpenForWriting()", FatalException,
+                ("Cannot create phase-space file " + filename).c_str());
+
+  uint32_t record_size = sizeof(PhaseSpaceRecord);
+  file_.write(magic_v1, sizeof(magic_v1));
+  file_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  file_.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+
+  writing_ = true;
+  buffer_.clear();
+  buffer_.reserve(block_size);
+  n_records_ = 0;
+}
+
+
+
+void PhaseSpaceFile::OpenForReading(const G4String& filename)
+{
+  Close();
+
+  file_.open(filename, std::ios::in | std::ios::binary);
+  if (!file_.is_open())
+    G4Exception("[PhaseSpaceFile]", "OpenForReading()", FatalException,
+                ("Cannot open phase-space file " + filename).c_str());
+
+  char magic[8];
+  uint32_t file_version = 0, record_size = 0;
+  file_.read(magic, sizeof(magic));
+  file_.read(reinterpret_cast<char*>(&file_version), sizeof(file_version));
+  file_.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+  if (!file_.good() || std::memcmp(magic, magic_v1, sizeof(magic)) != 0 ||
+      file_version != version || record_size != sizeof(PhaseSpaceRecord))
+    G4Exception("[PhaseSpaceFile]", "OpenForReading()", FatalException,
+                ("Wrong header in phase-space file " + filename).c_str());
+
+  writing_ = false;
+  buffer_.clear();
+  pos_ = 0;
+  n_records_ = 0;
+}
+
+
+
+void PhaseSpaceFile::Close()
+{
+  if (!file_.is_open()) return;
+  if (writing_) Flush();
+  file_.close();
+}
+
+
+
+void PhaseSpaceFile::Write(const PhaseSpaceRecord& record)
+{
+  buffer_.push_back(record);
+  n_records_++;
+  if (buffer_.size() == block_size) Flush();
+}
+
+
+
+void PhaseSpaceFile::Flush()
+{
+  file_.write(reinterpret_cast<const char*>(buffer_.data()),
+              buffer_.size() * sizeof(PhaseSpaceRecord));
+  buffer_.clear();
+}
+
+
+
+G4bool PhaseSpaceFile::Read(PhaseSpaceRecord& record)
+{
+  if (pos_ == buffer_.size()) {
+    Fill();
+    if (buffer_.empty()) return false;
+  }
+
+  record = buffer_[pos_++];
+  n_records_++;
+  return true;
+}
+
+
+
+void PhaseSpaceFile::Fill()
+{
+  buffer_.resize(block_size);
+  file_.read(reinterpret_cast<char*>(buffer_.data()),
+             block_size * sizeof(PhaseSpaceRecord));
+  buffer_.resize(file_.gcount() / sizeof(PhaseSpaceRecord));
+  pos_ = 0;
+}
@@ -0,0 +1,72 @@
+// ----------------------------------------------------------------------------
+// petalosim | PhaseSpaceFile.h
+//
+// Binary phase-space file, written by PetPhaseSpaceSteppingAction and read
+// by PhaseSpaceGenerator. The file starts with a 16-byte header (magic
+// "PETPSV1", null terminated, the uint32 format version and the uint32 size
+// of the records) followed by one fixed-size record per particle, in the
+// native byte order. Records of the same event are consecutive.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHASE_SPACE_FILE_H
+#define PHASE_SPACE_FILE_H
+
+#include <G4String.hh>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/// Particle crossing the phase-space surface. Lengths in mm,
+/// energies in MeV and times in ns.
+struct PhaseSpaceRecord {
+  int32_t event_id;
+  int32_t track_id;
+  int32_t parent_id;
+  int32_t pdg_code;
+  float   x, y, z;
+  float   dx, dy, dz;
+  float   kin_energy;
+  float   time;
+};
+
+class PhaseSpaceFile
+{
+public:
+  /// Constructor
+  PhaseSpaceFile();
+  /// Destructor: the file is closed, flushing pending records
+  ~PhaseSpaceFile();
+
+  /// Create a new file and write its header
+  void OpenForWriting(const G4String& filename);
+  /// Open an existing file and check its header
+  void OpenForReading(const G4String& filename);
+  void Close();
+  G4bool IsOpen() const;
+
+  /// Add a record to the file. Records are written in blocks.
+  void Write(const PhaseSpaceRecord& record);
+  /// Read the next record. Returns false at the end of the file.
+  G4bool Read(PhaseSpaceRecord& record);
+
+  /// Number of records written or read so far
+  G4long GetNumberOfRecords() const;
+
+private:
+  void Flush();
+  void Fill();
+
+  std::fstream file_;
+  G4bool writing_;
+  std::vector<PhaseSpaceRecord> buffer_; ///< block of records
+  size_t pos_;      ///< next record of the block, when reading
+  G4long n_records_;
+};
+
+inline G4bool PhaseSpaceFile::IsOpen() const { return file_.is_open(); }
+inline G4long PhaseSpaceFile::GetNumberOfRecords() const { return n_records_; }
+
+#endif
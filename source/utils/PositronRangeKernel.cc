@@ -0,0 +1,170 @@
+// ----------------------------------------------------------------------------
+// petalosim | PositronRangeKernel.cc
+//
+// Tabulated distribution of the distance between the decay of a positron
+// emitter and the annihilation of the positron in body tissue. It is used to
+// displace the annihilation point from the decay vertex without tracking
+// the positron. The built-in kernels are r * exp(-2r/R_mean), i.e.,
+// a gamma distribution of shape 2 with the mean range of each isotope
+// in water, truncated at its maximum range. Other kernels can be read
+// from a text file with two columns: distance (mm) and probability density.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PositronRangeKernel.h"
+
+#include <G4Exception.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4RandomDirection.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+  struct IsotopeRange {
+    const char* name;
+    G4double mean; // mean range in water, in mm
+    G4double max;  // maximum range in water, in mm
+  };
+
+  const IsotopeRange isotopes[] = {
+    {"F18",  0.6,  2.4},
+    {"C11",  1.2,  4.2},
+    {"N13",  1.8,  5.5},
+    {"O15",  3.0,  8.4},
+    {"Ga68", 2.9, 10.3},
+    {"Rb82", 5.9, 17.0},
+    {"Na22", 0.5,  2.1}
+  };
+
+  const G4int n_nodes = 512;
+
+}
+
+
+
+PositronRangeKernel::PositronRangeKernel(): mean_(0.)
+{
+}
+
+
+
+PositronRangeKernel::~PositronRangeKernel()
+{
+}
+
+
+
+void PositronRangeKernel::SetIsotope(const G4String& isotope)
+{
+  const IsotopeRange* iso = 0;
+  for (const IsotopeRange& i : isotopes)
+    if (isotope == i.name) iso = &i;
+
+  if (!iso) {
+    G4String msg = "Unknown isotope " + isotope +
+      ". Available ones: F18, C11, N13, O15, Ga68, Rb82, Na22.";
+    G4Exception("[PositronRangeKernel]", "SetIsotope()",
+                FatalException, msg);
+  }
+
+  G4double theta = iso->mean * mm / 2.;
+  G4double r_max = iso->max * mm;
+
+  std::vector<G4double> r(n_nodes), pdf(n_nodes);
+  for (G4int i=0; i<n_nodes; i++) {
+    r[i]   = r_max * i / (n_nodes - 1);
+    pdf[i] = r[i] * std::exp(-r[i] / theta);
+  }
+
+  BuildCDF(r, pdf);
+}
+
+
+
+void PositronRangeKernel::ReadTable(const G4String& filename)
+{
+  std::ifstream in(filename);
+  if (!in.good()) {
+    G4String msg = "Cannot open positron range file " + filename;
+    G4Exception("[PositronRangeKernel]", "ReadTable()",
+                FatalException, msg);
+  }
+
+  std::vector<G4double> r, pdf;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream ss(line);
+    G4double dist, dens;
+    if (!(ss >> dist >> dens)) continue;
+    if (!r.empty() && dist * mm <= r.back())
+      G4Exception("[PositronRangeKernel]", "ReadTable()", FatalException,
+                  "Distances of the positron range table must be increasing.");
+    if (dens < 0.)
+      G4Exception("[PositronRangeKernel]", "ReadTable()", FatalException,
+                  "Negative density in the positron range table.");
+    r.push_back(dist * mm);
+    pdf.push_back(dens);
+  }
+
+  if (r.size() < 2)
+    G4Exception("[PositronRangeKernel]", "ReadTable()", FatalException,
+                "The positron range table needs at least two rows.");
+
+  BuildCDF(r, pdf);
+}
+
+
+
+void PositronRangeKernel::BuildCDF(const std::vector<G4double>& r,
+                                   const std::vector<G4double>& pdf)
+{
+  // Trapezoidal integration between the nodes
+  r_   = r;
+  cdf_.assign(r.size(), 0.);
+  G4double sum_r = 0.;
+  for (size_t i=1; i<r.size(); i++) {
+    G4double p = 0.5 * (pdf[i] + pdf[i-1]) * (r[i] - r[i-1]);
+    cdf_[i] = cdf_[i-1] + p;
+    sum_r  += p * 0.5 * (r[i] + r[i-1]);
+  }
+
+  G4double total = cdf_.back();
+  if (total <= 0.)
+    G4Exception("[PositronRangeKernel]", "BuildCDF()", FatalException,
+                "The positron range kernel is empty.");
+
+  for (size_t i=0; i<cdf_.size(); i++)
+    cdf_[i] /= total;
+  mean_ = sum_r / total;
+}
+
+
+
+G4double PositronRangeKernel::SampleRange() const
+{
+  if (r_.empty()) return 0.;
+
+  // Linear interpolation of the inverse of the cumulative distribution
+  G4double u = G4UniformRand();
+  size_t i = std::upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin();
+  if (i == 0) return r_.front();
+  if (i >= cdf_.size()) return r_.back();
+
+  G4double width = cdf_[i] - cdf_[i-1];
+  G4double f = width > 0. ? (u - cdf_[i-1]) / width : 0.;
+  return r_[i-1] + f * (r_[i] - r_[i-1]);
+}
+
+
+
+G4ThreeVector PositronRangeKernel::SampleDisplacement() const
+{
+  return SampleRange() * G4RandomDirection();
+}
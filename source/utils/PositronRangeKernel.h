@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// petalosim | PositronRangeKernel.h
+//
+// Tabulated distribution of the distance between the decay of a positron
+// emitter and the annihilation of the positron in body tissue. It is used to
+// displace the annihilation point from the decay vertex without tracking
+// the positron. The built-in kernels are r * exp(-2r/R_mean), i.e.,
+// a gamma distribution of shape 2 with the mean range of each isotope
+// in water, truncated at its maximum range. Other kernels can be read
+// from a text file with two columns: distance (mm) and probability density.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef POSITRON_RANGE_KERNEL_H
+#define POSITRON_RANGE_KERNEL_H
+
+#include <G4ThreeVector.hh>
+#include <G4String.hh>
+
+#include <vector>
+
+class PositronRangeKernel
+{
+public:
+  /// Constructor of an empty kernel (no displacement)
+  PositronRangeKernel();
+  /// Destructor
+  ~PositronRangeKernel();
+
+  /// Build the kernel of one of the tabulated isotopes
+  /// (F18, C11, N13, O15, Ga68, Rb82, Na22)
+  void SetIsotope(const G4String& isotope);
+  /// Build the kernel from a radial probability density
+  /// tabulated in a text file
+  void ReadTable(const G4String& filename);
+
+  /// Return a random distance between decay and annihilation
+  G4double SampleRange() const;
+  /// Return a random displacement between decay and annihilation
+  G4ThreeVector SampleDisplacement() const;
+
+  /// True if a kernel has been built
+  G4bool IsSet() const;
+  /// Mean of the tabulated distances
+  G4double GetMeanRange() const;
+  /// Largest tabulated distance
+  G4double GetMaxRange() const;
+
+private:
+  /// Build the cumulative distribution from the density at the nodes
+  void BuildCDF(const std::vector<G4double>& r,
+                const std::vector<G4double>& pdf);
+
+  std::vector<G4double> r_;   ///< distances of the nodes
+  std::vector<G4double> cdf_; ///< cumulative probability at the nodes
+  G4double mean_;
+};
+
+inline G4bool PositronRangeKernel::IsSet() const { return !r_.empty(); }
+inline G4double PositronRangeKernel::GetMeanRange() const { return mean_; }
+inline G4double PositronRangeKernel::GetMaxRange() const
+{ return r_.empty() ? 0. : r_.back(); }
+
+#endif
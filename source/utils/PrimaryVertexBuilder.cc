@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// petalosim | PrimaryVertexBuilder.cc
+//
+// Helper of the generators which add many primaries of the same kind to
+// a vertex (optical photons, back-to-back gammas). The particle definition
+// is looked up only once, the random numbers of the directions of all the
+// particles of a vertex are drawn from the engine in a single batch, and
+// the primaries are built in one pass over the sampled values.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PrimaryVertexBuilder.h"
+
+#include <G4ParticleDefinition.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4PrimaryParticle.hh>
+#include <Randomize.hh>
+
+#include <CLHEP/Units/PhysicalConstants.h>
+
+#include <cmath>
+
+using namespace CLHEP;
+
+
+PrimaryVertexBuilder::PrimaryVertexBuilder(G4ParticleDefinition* particle):
+  particle_(particle), mass_(particle->GetPDGMass())
+{
+}
+
+
+
+PrimaryVertexBuilder::~PrimaryVertexBuilder()
+{
+}
+
+
+
+void PrimaryVertexBuilder::SampleDirections(G4int n,
+                                            std::vector<G4ThreeVector>& dirs)
+{
+  dirs.resize(n);
+  if (n == 0) return;
+
+  // Same distribution as G4RandomDirection: uniform cos(theta) and phi
+  rnd_.resize(2 * n);
+  G4Random::getTheEngine()->flatArray(2 * n, rnd_.data());
+
+  for (G4int i=0; i<n; i++) {
+    G4double cost = 1. - 2. * rnd_[2*i];
+    G4double sint = std::sqrt((1. - cost) * (1. + cost));
+    G4double phi  = twopi * rnd_[2*i+1];
+    dirs[i].set(sint * std::cos(phi), sint * std::sin(phi), cost);
+  }
+}
+
+
+
+void PrimaryVertexBuilder::AddIsotropic(G4PrimaryVertex* vertex,
+                                        const std::vector<G4double>& energies,
+                                        G4bool polarization)
+{
+  G4int n = energies.size();
+  SampleDirections(n, dirs_);
+  if (polarization)
+    SampleDirections(n, pols_);
+
+  for (G4int i=0; i<n; i++) {
+    G4double ekin = energies[i];
+    G4double pmod = std::sqrt(ekin * (ekin + 2. * mass_));
+    G4ThreeVector p = pmod * dirs_[i];
+
+    G4PrimaryParticle* particle =
+      new G4PrimaryParticle(particle_, p.x(), p.y(), p.z());
+    if (polarization)
+      particle->SetPolarization(pols_[i]);
+    vertex->SetPrimary(particle);
+  }
+}
+
+
+
+void PrimaryVertexBuilder::AddBackToBack(G4PrimaryVertex* vertex,
+                                         G4int n_pairs, G4double energy)
+{
+  SampleDirections(n_pairs, dirs_);
+
+  G4double pmod = std::sqrt(energy * (energy + 2. * mass_));
+
+  for (G4int i=0; i<n_pairs; i++) {
+    G4ThreeVector p = pmod * dirs_[i];
+
+    G4PrimaryParticle* particle1 =
+      new G4PrimaryParticle(particle_, p.x(), p.y(), p.z());
+    particle1->SetPolarization(0., 0., 0.);
+    vertex->SetPrimary(particle1);
+
+    G4PrimaryParticle* particle2 =
+      new G4PrimaryParticle(particle_, -p.x(), -p.y(), -p.z());
+    particle2->SetPolarization(0., 0., 0.);
+    vertex->SetPrimary(particle2);
+  }
+}
@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// petalosim | PrimaryVertexBuilder.h
+//
+// Helper of the generators which add many primaries of the same kind to
+// a vertex (optical photons, back-to-back gammas). The particle definition
+// is looked up only once, the random numbers of the directions of all the
+// particles of a vertex are drawn from the engine in a single batch, and
+// the primaries are built in one pass over the sampled values.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PRIMARY_VERTEX_BUILDER_H
+#define PRIMARY_VERTEX_BUILDER_H
+
+#include <G4ThreeVector.hh>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4PrimaryVertex;
+
+class PrimaryVertexBuilder
+{
+public:
+  /// Constructor for primaries of the given kind
+  PrimaryVertexBuilder(G4ParticleDefinition* particle);
+  /// Destructor
+  ~PrimaryVertexBuilder();
+
+  /// Add to the vertex one particle per kinetic energy, with isotropic
+  /// directions and, optionally, random polarization vectors
+  void AddIsotropic(G4PrimaryVertex* vertex,
+                    const std::vector<G4double>& energies,
+                    G4bool polarization=false);
+
+  /// Add to the vertex n pairs of particles with the same kinetic energy,
+  /// emitted back to back in isotropic directions
+  void AddBackToBack(G4PrimaryVertex* vertex, G4int n_pairs,
+                     G4double energy);
+
+  /// Fill the vector with n isotropic unit vectors
+  void SampleDirections(G4int n, std::vector<G4ThreeVector>& dirs);
+
+  G4ParticleDefinition* GetParticleDefinition() const;
+
+private:
+  G4ParticleDefinition* particle_;
+  G4double mass_;
+
+  std::vector<G4double> rnd_;        ///< random numbers of one batch
+  std::vector<G4ThreeVector> dirs_;  ///< directions of one vertex
+  std::vector<G4ThreeVector> pols_;  ///< polarizations of one vertex
+};
+
+inline G4ParticleDefinition* PrimaryVertexBuilder::GetParticleDefinition() const
+{ return particle_; }
+
+#endif
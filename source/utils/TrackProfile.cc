@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// petalosim | TrackProfile.cc
+//
+// Wall time, number of tracks and number of steps spent on each particle
+// species, per event and per run, together with the largest size reached
+// by each hits collection and the peak resident memory of the process.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "TrackProfile.h"
+
+#include <G4HCofThisEvent.hh>
+#include <G4VHitsCollection.hh>
+#include <G4ios.hh>
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <iomanip>
+
+
+namespace {
+  const char* species_names[TrackProfile::kNSpecies] =
+    {"gamma", "e-", "e+", "opticalphoton", "thermalelectron", "other"};
+}
+
+
+
+TrackProfile::TrackProfile(): n_events_(0), peak_rss_(0), save_table_(true)
+{
+  for (G4int i=0; i<kNSpecies; i++)
+    current_[i] = event_[i] = run_[i] = Counters{0, 0, 0.};
+}
+
+
+
+TrackProfile::~TrackProfile()
+{
+}
+
+
+
+const char* TrackProfile::GetSpeciesName(G4int species)
+{
+  return species_names[species];
+}
+
+
+
+void TrackProfile::EndEvent(G4HCofThisEvent* hce)
+{
+  for (G4int i=0; i<kNSpecies; i++) {
+    event_[i] = current_[i];
+    run_[i].tracks += current_[i].tracks;
+    run_[i].steps  += current_[i].steps;
+    run_[i].time   += current_[i].time;
+    current_[i] = Counters{0, 0, 0.};
+  }
+  n_events_++;
+
+  if (hce) {
+    for (G4int i=0; i<hce->GetNumberOfCollections(); i++) {
+      G4VHitsCollection* hc = hce->GetHC(i);
+      if (!hc) continue;
+      size_t& peak = peak_hits_[hc->GetName()];
+      peak = std::max(peak, hc->GetSize());
+    }
+  }
+
+  // ru_maxrss is given in kB on Linux
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    peak_rss_ = std::max(peak_rss_, (G4long) usage.ru_maxrss);
+}
+
+
+
+void TrackProfile::PrintSummary() const
+{
+  G4double total_time = 0.;
+  for (G4int i=0; i<kNSpecies; i++)
+    total_time += run_[i].time;
+
+  G4long n = std::max(n_events_, 1L);
+
+  G4cout << "------------------------------------------------------------\n"
+         << " Tracking profile of " << n_events_ << " events\n"
+         << std::setw(17) << "species"
+         << std::setw(14) << "tracks/evt"
+         << std::setw(14) << "steps/evt"
+         << std::setw(14) << "ms/evt"
+         << std::setw(9)  << "time %" << "\n";
+  for (G4int i=0; i<kNSpecies; i++) {
+    if (run_[i].tracks == 0) continue;
+    G4double frac = total_time > 0. ? 100. * run_[i].time / total_time : 0.;
+    G4cout << std::setw(17) << species_names[i]
+           << std::setw(14) << (G4double) run_[i].tracks / n
+           << std::setw(14) << (G4double) run_[i].steps / n
+           << std::setw(14) << 1.e3 * run_[i].time / n
+           << std::setw(9)  << std::setprecision(3) << frac
+           << std::setprecision(6) << "\n";
+  }
+  for (auto& hc: peak_hits_)
+    G4cout << " Peak size of hits collection " << hc.first << ": "
+           << hc.second << "\n";
+  G4cout << " Peak resident memory: " << peak_rss_ / 1024. << " MB\n"
+         << "------------------------------------------------------------"
+         << G4endl;
+}
+
+
+
+void TrackProfile::ResetRun()
+{
+  for (G4int i=0; i<kNSpecies; i++)
+    run_[i] = Counters{0, 0, 0.};
+  n_events_ = 0;
+  peak_hits_.clear();
+}
@@ -0,0 +1,103 @@
+// ----------------------------------------------------------------------------
+// petalosim | TrackProfile.h
+//
+// Wall time, number of tracks and number of steps spent on each particle
+// species, per event and per run, together with the largest size reached
+// by each hits collection and the peak resident memory of the process.
+// It is filled by PetProfilingTrackingAction and read by the persistency
+// manager at the end of each event.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef TRACK_PROFILE_H
+#define TRACK_PROFILE_H
+
+#include <G4Types.hh>
+#include <G4String.hh>
+
+#include <map>
+
+class G4HCofThisEvent;
+
+class TrackProfile
+{
+public:
+  /// Species profiled separately
+  enum Species { kGamma, kElectron, kPositron, kOpticalPhoton,
+                 kThermalElectron, kOther, kNSpecies };
+
+  /// Constructor
+  TrackProfile();
+  /// Destructor
+  ~TrackProfile();
+
+  /// Name of a species, as written in the output
+  static const char* GetSpeciesName(G4int species);
+
+  /// Add a track of the current event, with the wall time (in seconds)
+  /// spent tracking it
+  void AddTrack(G4int species, G4double wall_time, G4int n_steps);
+
+  /// Close the current event: its counters become the ones returned by
+  /// the getters, and are added to the run totals. The sizes of the hits
+  /// collections of the event update the peak sizes.
+  void EndEvent(G4HCofThisEvent* hce);
+
+  /// Counters of the last closed event
+  G4long GetTracks(G4int species) const;
+  G4long GetSteps(G4int species) const;
+  G4double GetWallTime(G4int species) const;
+
+  /// Largest number of hits per event of each collection
+  const std::map<G4String, size_t>& GetPeakHits() const;
+  /// Peak resident set size of the process, in kB
+  G4long GetPeakRSS() const;
+
+  /// Print the totals and averages per event of the run
+  void PrintSummary() const;
+  /// Reset the run totals
+  void ResetRun();
+
+  void SetSaveTable(G4bool save);
+  G4bool GetSaveTable() const;
+
+private:
+  struct Counters {
+    G4long tracks;
+    G4long steps;
+    G4double time;
+  };
+
+  Counters current_[kNSpecies]; ///< event being tracked
+  Counters event_[kNSpecies];   ///< last closed event
+  Counters run_[kNSpecies];     ///< sum over the closed events of the run
+
+  G4long n_events_;
+  std::map<G4String, size_t> peak_hits_;
+  G4long peak_rss_;
+
+  G4bool save_table_; ///< Write the profile of each event to the output file
+};
+
+inline void TrackProfile::AddTrack(G4int species, G4double wall_time,
+                                   G4int n_steps)
+{
+  current_[species].tracks++;
+  current_[species].steps += n_steps;
+  current_[species].time  += wall_time;
+}
+
+inline G4long TrackProfile::GetTracks(G4int species) const
+{ return event_[species].tracks; }
+inline G4long TrackProfile::GetSteps(G4int species) const
+{ return event_[species].steps; }
+inline G4double TrackProfile::GetWallTime(G4int species) const
+{ return event_[species].time; }
+inline const std::map<G4String, size_t>& TrackProfile::GetPeakHits() const
+{ return peak_hits_; }
+inline G4long TrackProfile::GetPeakRSS() const { return peak_rss_; }
+inline void TrackProfile::SetSaveTable(G4bool save) { save_table_ = save; }
+inline G4bool TrackProfile::GetSaveTable() const { return save_table_; }
+
+#endif
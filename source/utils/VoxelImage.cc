@@ -0,0 +1,162 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelImage.cc
+//
+// Three-dimensional image on a regular grid of voxels (e.g., an attenuation
+// or activity map), read either from a NIfTI-1 file (.nii, uncompressed)
+// or from a raw file of little-endian float32 values. In both cases the
+// voxel index is ix + nx * (iy + ny * iz), i.e., x runs fastest.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VoxelImage.h"
+
+#include <G4Exception.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+  // Fields of the NIfTI-1 header used here
+  struct NIfTIHeader {
+    int32_t sizeof_hdr;   // must be 348
+    char    unused1[36];
+    int16_t dim[8];       // number of dimensions, then size along each one
+    char    unused2[14];
+    int16_t datatype;
+    int16_t bitpix;
+    int16_t slice_start;
+    float   pixdim[8];    // voxel size, in mm
+    float   vox_offset;   // offset of the data in the file
+    float   scl_slope;
+    float   scl_inter;
+    char    unused3[224];
+    char    magic[4];     // "n+1" for single files
+  };
+
+  static_assert(sizeof(NIfTIHeader) == 348, "Wrong size of NIfTI header");
+
+  template <typename T>
+  void ReadValues(std::ifstream& is, std::vector<G4float>& data)
+  {
+    std::vector<T> buffer(data.size());
+    is.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(T));
+    if (is.gcount() != (std::streamsize)(buffer.size() * sizeof(T)))
+      G4Exception("[VoxelImage]", "Read()", FatalException,
+                  "Image file shorter than its number of voxels.");
+    for (size_t i=0; i<buffer.size(); i++)
+      data[i] = buffer[i];
+  }
+
+}
+
+
+
+VoxelImage::VoxelImage(): nx_(0), ny_(0), nz_(0)
+{
+}
+
+
+
+VoxelImage::~VoxelImage()
+{
+}
+
+
+
+void VoxelImage::Read(const G4String& filename, G4int nx, G4int ny, G4int nz,
+                      G4ThreeVector voxel_size)
+{
+  if (G4StrUtil::ends_with(filename, ".nii")) {
+    ReadNIfTI(filename);
+  } else {
+    nx_ = nx;
+    ny_ = ny;
+    nz_ = nz;
+    voxel_size_ = voxel_size;
+    ReadRaw(filename);
+  }
+
+  // NaN or infinite values cannot be mapped to materials or activities
+  for (size_t i=0; i<data_.size(); i++) {
+    if (!std::isfinite(data_[i]))
+      G4Exception("[VoxelImage]", "Read()", FatalException,
+                  ("Non-finite value in image file " + filename).c_str());
+  }
+}
+
+
+
+void VoxelImage::ReadNIfTI(const G4String& filename)
+{
+  std::ifstream is(filename, std::ifstream::binary);
+  if (!is.good())
+    G4Exception("[VoxelImage]", "ReadNIfTI()", FatalException,
+                ("Cannot open image file " + filename).c_str());
+
+  NIfTIHeader hdr;
+  is.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+  if (!is.good() || hdr.sizeof_hdr != 348 ||
+      std::strncmp(hdr.magic, "n+1", 4) != 0)
+    G4Exception("[VoxelImage]", "ReadNIfTI()", FatalException,
+                "Not a single-file NIfTI-1 image in native byte order.");
+  if (hdr.dim[0] < 3 || (hdr.dim[0] > 3 && hdr.dim[4] > 1))
+    G4Exception("[VoxelImage]", "ReadNIfTI()", FatalException,
+                "Only three-dimensional NIfTI images can be used.");
+
+  nx_ = hdr.dim[1];
+  ny_ = hdr.dim[2];
+  nz_ = hdr.dim[3];
+  voxel_size_.set(hdr.pixdim[1] * mm, hdr.pixdim[2] * mm, hdr.pixdim[3] * mm);
+
+  data_.assign((size_t)nx_ * ny_ * nz_, 0.);
+  is.seekg((std::streamoff)hdr.vox_offset);
+
+  switch (hdr.datatype) {
+  case 2:   ReadValues<uint8_t> (is, data_); break;
+  case 4:   ReadValues<int16_t> (is, data_); break;
+  case 8:   ReadValues<int32_t> (is, data_); break;
+  case 16:  ReadValues<float>   (is, data_); break;
+  case 64:  ReadValues<double>  (is, data_); break;
+  case 256: ReadValues<int8_t>  (is, data_); break;
+  case 512: ReadValues<uint16_t>(is, data_); break;
+  default:
+    G4Exception("[VoxelImage]", "ReadNIfTI()", FatalException,
+                "Unsupported NIfTI data type.");
+  }
+
+  // Scaling of the stored values, if any
+  if (hdr.scl_slope != 0. && !(hdr.scl_slope == 1. && hdr.scl_inter == 0.)) {
+    for (size_t i=0; i<data_.size(); i++)
+      data_[i] = hdr.scl_slope * data_[i] + hdr.scl_inter;
+  }
+}
+
+
+
+void VoxelImage::ReadRaw(const G4String& filename)
+{
+  if (nx_ <= 0 || ny_ <= 0 || nz_ <= 0 || voxel_size_.x() <= 0. ||
+      voxel_size_.y() <= 0. || voxel_size_.z() <= 0.)
+    G4Exception("[VoxelImage]", "ReadRaw()", FatalException,
+                "Number and size of voxels needed for raw images.");
+
+  std::ifstream is(filename, std::ifstream::binary);
+  if (!is.good())
+    G4Exception("[VoxelImage]", "ReadRaw()", FatalException,
+                ("Cannot open image file " + filename).c_str());
+
+  data_.assign((size_t)nx_ * ny_ * nz_, 0.);
+  ReadValues<float>(is, data_);
+}
+
+
+
+void VoxelImage::Clear()
+{
+  std::vector<G4float>().swap(data_);
+}
@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelImage.h
+//
+// Three-dimensional image on a regular grid of voxels (e.g., an attenuation
+// or activity map), read either from a NIfTI-1 file (.nii, uncompressed)
+// or from a raw file of little-endian float32 values. In both cases the
+// voxel index is ix + nx * (iy + ny * iz), i.e., x runs fastest.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VOXEL_IMAGE_H
+#define VOXEL_IMAGE_H
+
+#include <G4ThreeVector.hh>
+#include <G4String.hh>
+#include <vector>
+
+class VoxelImage
+{
+public:
+  /// Constructor of an empty image
+  VoxelImage();
+  /// Destructor
+  ~VoxelImage();
+
+  /// Read a file, in NIfTI format if its name ends in .nii and in raw
+  /// format otherwise. The number of voxels and their size are taken
+  /// from the header in NIfTI files and from the arguments in raw files.
+  /// Images with NaN or infinite values are rejected.
+  void Read(const G4String& filename, G4int nx=0, G4int ny=0, G4int nz=0,
+            G4ThreeVector voxel_size=G4ThreeVector());
+
+  G4int GetNx() const;
+  G4int GetNy() const;
+  G4int GetNz() const;
+  /// Full size of one voxel
+  const G4ThreeVector& GetVoxelSize() const;
+  /// Values of all the voxels
+  const std::vector<G4float>& GetData() const;
+
+  /// Release the memory used by the values
+  void Clear();
+
+private:
+  void ReadNIfTI(const G4String& filename);
+  void ReadRaw(const G4String& filename);
+
+  G4int nx_, ny_, nz_;
+  G4ThreeVector voxel_size_;
+  std::vector<G4float> data_;
+};
+
+inline G4int VoxelImage::GetNx() const { return nx_; }
+inline G4int VoxelImage::GetNy() const { return ny_; }
+inline G4int VoxelImage::GetNz() const { return nz_; }
+inline const G4ThreeVector& VoxelImage::GetVoxelSize() const
+{ return voxel_size_; }
+inline const std::vector<G4float>& VoxelImage::GetData() const
+{ return data_; }
+
+#endif
@@ -0,0 +1,143 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelPointSampler.cc
+//
+// Generator of random points following an activity map defined on a
+// regular grid of voxels centred at the origin. The voxel is chosen with
+// an alias table and the point is distributed uniformly inside it.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VoxelPointSampler.h"
+
+#include <G4Exception.hh>
+#include <Randomize.hh>
+
+VoxelPointSampler::VoxelPointSampler(G4int nx, G4int ny, G4int nz,
+                                     G4double lx, G4double ly, G4double lz):
+  nx_(nx), ny_(ny), nz_(nz), lx_(lx), ly_(ly), lz_(lz), voxel_ptr_(0)
+{
+  if (nx <= 0 || ny <= 0 || nz <= 0)
+    G4Exception("[VoxelPointSampler]", "VoxelPointSampler()",
+                FatalErrorInArgument, "Wrong number of voxels.");
+}
+
+
+
+VoxelPointSampler::~VoxelPointSampler()
+{
+}
+
+
+
+void VoxelPointSampler::SetActivity(const std::vector<G4double>& activity)
+{
+  if ((G4int)activity.size() != GetNumberOfVoxels())
+    G4Exception("[VoxelPointSampler]", "SetActivity()", FatalErrorInArgument,
+                "Size of activity map different from number of voxels.");
+
+  // Only voxels with activity enter the alias table
+  voxels_.clear();
+  std::vector<G4double> weights;
+  for (size_t i=0; i<activity.size(); i++) {
+    if (activity[i] > 0.) {
+      voxels_.push_back(i);
+      weights.push_back(activity[i]);
+    }
+  }
+
+  sampler_.SetWeights(weights);
+  voxel_ptr_ = voxels_.data();
+}
+
+
+
+void VoxelPointSampler::SetActivity(const std::vector<unsigned int>& voxels,
+                                    const std::vector<G4double>& activity)
+{
+  if (voxels.size() != activity.size())
+    G4Exception("[VoxelPointSampler]", "SetActivity()", FatalErrorInArgument,
+                "Different number of voxels and activities.");
+
+  voxels_.clear();
+  std::vector<G4double> weights;
+  for (size_t i=0; i<voxels.size(); i++) {
+    if ((G4int)voxels[i] >= GetNumberOfVoxels())
+      G4Exception("[VoxelPointSampler]", "SetActivity()",
+                  FatalErrorInArgument, "Voxel index out of range.");
+    if (activity[i] > 0.) {
+      voxels_.push_back(voxels[i]);
+      weights.push_back(activity[i]);
+    }
+  }
+
+  sampler_.SetWeights(weights);
+  voxel_ptr_ = voxels_.data();
+}
+
+
+
+void VoxelPointSampler::SetCumulativeActivity(const std::vector<G4float>& cdf)
+{
+  if ((G4int)cdf.size() != GetNumberOfVoxels())
+    G4Exception("[VoxelPointSampler]", "SetCumulativeActivity()",
+                FatalErrorInArgument,
+                "Size of activity map different from number of voxels.");
+
+  // Voxel i is chosen when cdf[i] <= u < cdf[i+1], with u uniform in [0, 1)
+  voxels_.clear();
+  std::vector<G4double> weights;
+  for (size_t i=0; i<cdf.size(); i++) {
+    G4double next = (i+1 < cdf.size()) ? (G4double)cdf[i+1] : 1.;
+    G4double w = next - (G4double)cdf[i];
+    if (w > 0.) {
+      voxels_.push_back(i);
+      weights.push_back(w);
+    }
+  }
+
+  sampler_.SetWeights(weights);
+  voxel_ptr_ = voxels_.data();
+}
+
+
+
+void VoxelPointSampler::SetTables(size_t n, const unsigned int* voxels,
+                                  const G4double* prob,
+                                  const unsigned int* alias)
+{
+  voxels_.clear();
+  sampler_.SetTables(n, prob, alias);
+  voxel_ptr_ = voxels;
+}
+
+
+
+G4ThreeVector VoxelPointSampler::GetVoxelCentre(unsigned int voxel) const
+{
+  G4int ix = voxel / (ny_ * nz_);
+  G4int iy = (voxel / nz_) % ny_;
+  G4int iz = voxel % nz_;
+
+  return G4ThreeVector(lx_ * ((ix + 0.5) / nx_ - 0.5),
+                       ly_ * ((iy + 0.5) / ny_ - 0.5),
+                       lz_ * ((iz + 0.5) / nz_ - 0.5));
+}
+
+
+
+G4ThreeVector VoxelPointSampler::GenerateVertex() const
+{
+  unsigned int voxel = voxel_ptr_[sampler_.Sample()];
+
+  G4int ix = voxel / (ny_ * nz_);
+  G4int iy = (voxel / nz_) % ny_;
+  G4int iz = voxel % nz_;
+
+  // Uniform point inside the voxel
+  G4double x = lx_ * ((ix + G4UniformRand()) / nx_ - 0.5);
+  G4double y = ly_ * ((iy + G4UniformRand()) / ny_ - 0.5);
+  G4double z = lz_ * ((iz + G4UniformRand()) / nz_ - 0.5);
+
+  return G4ThreeVector(x, y, z);
+}
@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// petalosim | VoxelPointSampler.h
+//
+// Generator of random points following an activity map defined on a
+// regular grid of voxels centred at the origin. The voxel is chosen with
+// an alias table and the point is distributed uniformly inside it.
+//
+// The PETALO Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VOXEL_POINT_SAMPLER_H
+#define VOXEL_POINT_SAMPLER_H
+
+#include "AliasSampler.h"
+
+#include <G4ThreeVector.hh>
+#include <vector>
+
+class VoxelPointSampler
+{
+public:
+  /// Constructor from the number of voxels and the total length of the
+  /// grid along each axis. Voxels are indexed as (ix * ny + iy) * nz + iz.
+  VoxelPointSampler(G4int nx, G4int ny, G4int nz,
+                    G4double lx, G4double ly, G4double lz);
+  /// Destructor
+  ~VoxelPointSampler();
+
+  /// Set the activity of all the voxels of the grid
+  void SetActivity(const std::vector<G4double>& activity);
+  /// Set the activity of the given voxels only; the rest have none
+  void SetActivity(const std::vector<unsigned int>& voxels,
+                   const std::vector<G4double>& activity);
+  /// Set the activity of all the voxels of the grid from its
+  /// cumulative distribution, as stored in the point files.
+  /// Differences are taken in double precision.
+  void SetCumulativeActivity(const std::vector<G4float>& cdf);
+  /// Use the voxels with activity and their alias tables from external
+  /// memory (e.g., a mapped point file), which must outlive the sampler
+  void SetTables(size_t n, const unsigned int* voxels,
+                 const G4double* prob, const unsigned int* alias);
+
+  /// Return a random point
+  G4ThreeVector GenerateVertex() const;
+
+  /// Return the centre of a voxel
+  G4ThreeVector GetVoxelCentre(unsigned int voxel) const;
+
+  G4int GetNumberOfVoxels() const;
+  /// Number of voxels with some activity
+  size_t GetNumberOfActiveVoxels() const;
+
+private:
+  G4int nx_, ny_, nz_;
+  G4double lx_, ly_, lz_;
+
+  std::vector<unsigned int> voxels_; ///< voxels with some activity
+  const unsigned int* voxel_ptr_;    ///< voxels_ or external table
+  AliasSampler sampler_;
+};
+
+inline G4int VoxelPointSampler::GetNumberOfVoxels() const
+{ return nx_ * ny_ * nz_; }
+
+inline size_t VoxelPointSampler::GetNumberOfActiveVoxels() const
+{ return sampler_.GetSize(); }
+
+#endif
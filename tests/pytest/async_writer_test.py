@@ -0,0 +1,19 @@
+import pytest
+
+import pandas as pd
+
+
+@pytest.mark.parametrize("table", ["particles", "hits", "sns_response",
+                                   "tof_sns_response", "sns_positions"])
+def test_async_writer_same_output(file_names_async_writer, table):
+     """
+     The same run written by the writer thread must give
+     the same tables as the one written event by event.
+     """
+
+     file_sync, file_async = file_names_async_writer
+
+     sync   = pd.read_hdf(file_sync,  'MC/'+table)
+     async_ = pd.read_hdf(file_async, 'MC/'+table)
+
+     pd.testing.assert_frame_equal(sync, async_)
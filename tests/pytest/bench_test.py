@@ -0,0 +1,49 @@
+import pytest
+
+import os
+import json
+import subprocess
+
+
+def test_petalo_bench_report(PETALODIR, output_tmpdir):
+     """
+     Run the benchmark driver on the cheapest workload
+     and check the JSON report.
+     """
+
+     bench_dir = os.path.join(output_tmpdir, 'bench')
+     command   = [PETALODIR + '/bin/petalo-bench', '-n', '4',
+                  '-w', 'sensitivity_map', '-d', bench_dir]
+     p = subprocess.run(command, check=True, cwd=PETALODIR,
+                        capture_output=True, text=True)
+
+     report = json.loads(p.stdout)
+     assert report['nevents'] == 4
+     assert len(report['workloads']) == 1
+
+     w = report['workloads'][0]
+     assert w['name'] == 'sensitivity_map'
+     assert w['ok']
+     assert w['startup_time_s'] > 0
+     assert w['events_per_s']  >= 0
+     assert w['peak_rss_kb']    > 0
+     assert w['output_bytes']   > 0
+
+
+def test_petalo_bench_ray_tracing(PETALODIR, output_tmpdir):
+     """
+     The ray-tracing workload must run and tell in the report that its
+     event selection differs from the one of full_body. Its rate is
+     compared with full_body by petalo-bench, not here.
+     """
+
+     bench_dir = os.path.join(output_tmpdir, 'bench_rt')
+     command   = [PETALODIR + '/bin/petalo-bench', '-n', '1',
+                  '-w', 'full_body_rt', '-d', bench_dir]
+     p = subprocess.run(command, check=True, cwd=PETALODIR,
+                        capture_output=True, text=True)
+
+     w = json.loads(p.stdout)['workloads'][0]
+     assert w['name'] == 'full_body_rt'
+     assert w['ok']
+     assert 'note' in w
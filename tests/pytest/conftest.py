@@ -30,6 +30,13 @@ def params_full_body(output_tmpdir, base_name_full_body):
     return os.path.join(output_tmpdir, base_name_full_body+'.h5'), n_sipm, n_boards, sipms_per_board, board_ordering
 
 
+@pytest.fixture(scope = 'session')
+def file_names_async_writer(output_tmpdir, base_name_full_body):
+    sync  = os.path.join(output_tmpdir, base_name_full_body+'.h5')
+    async_ = os.path.join(output_tmpdir, base_name_full_body+'_async.h5')
+    return sync, async_
+
+
 @pytest.fixture(scope = 'session')
 def base_name_nest():
     return 'PET_nest_test'
@@ -69,6 +76,94 @@ def file_name_phantom(output_tmpdir, base_name_phantom):
     return os.path.join(output_tmpdir, base_name_phantom+'.h5')
 
 
+@pytest.fixture(scope = 'session')
+def base_name_phase_space():
+    return 'PET_phase_space_test'
+
+@pytest.fixture(scope = 'session')
+def file_names_phase_space(output_tmpdir, base_name_phase_space):
+    return (os.path.join(output_tmpdir, base_name_phase_space+'.psf'),
+            os.path.join(output_tmpdir, base_name_phase_space+'_replay.h5'))
+
+
+@pytest.fixture(scope = 'session')
+def base_name_lut():
+    return 'PET_lut_test'
+
+@pytest.fixture(scope = 'session')
+def file_name_lut(output_tmpdir, base_name_lut):
+    return os.path.join(output_tmpdir, base_name_lut+'.h5')
+
+
+@pytest.fixture(scope = 'session')
+def base_name_sensitivity():
+    return 'PET_sensitivity_test'
+
+@pytest.fixture(scope = 'session')
+def file_name_sensitivity(output_tmpdir, base_name_sensitivity):
+    return os.path.join(output_tmpdir, base_name_sensitivity+'.h5')
+
+@pytest.fixture(scope = 'session')
+def base_name_sensitivity_slice():
+    return 'PET_sensitivity_slice_test'
+
+@pytest.fixture(scope = 'session')
+def file_name_sensitivity_slice(output_tmpdir, base_name_sensitivity_slice):
+    return os.path.join(output_tmpdir, base_name_sensitivity_slice+'.h5')
+
+
+@pytest.fixture(scope = 'session')
+def base_name_positron_range():
+    return 'PET_positron_range_test'
+
+@pytest.fixture(scope = 'session')
+def file_name_positron_range(output_tmpdir, base_name_positron_range):
+    return os.path.join(output_tmpdir, base_name_positron_range+'.h5')
+
+
+@pytest.fixture(scope = 'session')
+def base_name_per_event_seeding():
+    return 'PET_per_event_seeding_test'
+
+@pytest.fixture(scope = 'session', params=['Back2backGammas', 'SingleParticleGenerator'])
+def file_names_per_event_seeding(request, output_tmpdir, base_name_per_event_seeding):
+    base  = f'{base_name_per_event_seeding}_{request.param}'
+    full  = os.path.join(output_tmpdir, base+'_0.h5')
+    split = os.path.join(output_tmpdir, base+'_3.h5')
+    return full, split
+
+
+@pytest.fixture(scope = 'session')
+def base_name_profile():
+    return 'PET_profile_test'
+
+@pytest.fixture(scope = 'session')
+def file_name_profile(output_tmpdir, base_name_profile):
+    return os.path.join(output_tmpdir, base_name_profile+'.h5')
+
+
+@pytest.fixture(scope = 'session')
+def base_name_parameterised_sensors():
+    return 'PET_parameterised_sensors_test'
+
+@pytest.fixture(scope = 'session')
+def file_names_parameterised_sensors(output_tmpdir, base_name_parameterised_sensors):
+    placement     = os.path.join(output_tmpdir, base_name_parameterised_sensors+'.h5')
+    parameterised = os.path.join(output_tmpdir, base_name_parameterised_sensors+'_param.h5')
+    return placement, parameterised
+
+
+@pytest.fixture(scope = 'session')
+def base_name_optical_transport():
+    return 'PET_optical_transport_test'
+
+@pytest.fixture(scope = 'session')
+def file_names_optical_transport(output_tmpdir, base_name_optical_transport):
+    geant4      = os.path.join(output_tmpdir, base_name_optical_transport+'.h5')
+    ray_tracing = os.path.join(output_tmpdir, base_name_optical_transport+'_rt.h5')
+    return geant4, ray_tracing
+
+
 @pytest.fixture(scope = 'session')
 def base_name_pyrex():
     return 'PETit_pyrex_test'
@@ -0,0 +1,46 @@
+import pandas as pd
+import tables as tb
+import numpy as np
+
+
+def test_lut_structure(file_name_lut):
+     """Check that in LUT mode only the light-response table is saved."""
+
+     with tb.open_file(file_name_lut) as h5out:
+
+         assert 'lut'        in h5out.root.MC
+         assert 'lut_points' in h5out.root.MC
+         assert len(h5out.root.MC.tof_sns_response) == 0
+         assert len(h5out.root.MC.particles)        == 0
+
+         lcolumns = h5out.root.MC.lut.colnames
+         assert 'point_id'    in lcolumns
+         assert 'sensor_id'   in lcolumns
+         assert 'probability' in lcolumns
+         assert 'counts'      in lcolumns
+         assert 'mean_time'   in lcolumns
+         assert 'rms_time'    in lcolumns
+
+
+def test_lut_points_and_probabilities(file_name_lut):
+     """
+     Check that each event is accumulated in one point with the expected
+     number of events and that the detection probabilities are consistent
+     with the number of photons generated.
+     """
+
+     points = pd.read_hdf(file_name_lut, 'MC/lut_points')
+     lut    = pd.read_hdf(file_name_lut, 'MC/lut')
+
+     assert points.n_events.sum() == 20
+     assert np.all(points.n_events == 2)
+     assert np.all(points.n_photons == 1000 * points.n_events)
+
+     r = np.sqrt(points.x**2 + points.y**2)
+     assert np.all(r >= 165)
+     assert np.all(r <  195)
+
+     assert np.all(lut.point_id.isin(points.point_id))
+     assert np.all(lut.probability >  0)
+     assert lut.groupby('point_id').probability.sum().max() <= 1
+     assert np.all(lut.rms_time >= 0)
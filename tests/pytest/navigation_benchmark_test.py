@@ -0,0 +1,86 @@
+import pytest
+
+import os
+import re
+import subprocess
+
+
+def run_navigation_benchmark(config_tmpdir, output_tmpdir, PETALODIR, base_name, settings):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 2
+{settings}
+
+/Generator/Back2back/region AD_HOC
+
+/petalosim/navigation/seed 1234
+/petalosim/navigation/benchmark 2000
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+"""
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '0', init_path]
+     p = subprocess.run(command, check=True, capture_output=True, text=True)
+
+     steps_per_s   = re.search(r'steps/s\s+=\s+(\S+)',   p.stdout)
+     steps_per_ray = re.search(r'steps/ray\s+=\s+(\S+)', p.stdout)
+     assert steps_per_s and steps_per_ray
+     return float(steps_per_s.group(1)), float(steps_per_ray.group(1))
+
+
+def test_navigation_benchmark(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     The same rays must cross the same volumes whatever the
+     navigation settings of the volumes with many daughters.
+     """
+
+     rate, steps = run_navigation_benchmark(config_tmpdir, output_tmpdir,
+                                            PETALODIR, 'PET_navigation_test', '')
+     assert rate  > 0
+     assert steps > 1
+
+     settings = """
+/Geometry/FullRingInfinity/smartless_active 8.
+/Geometry/FullRingInfinity/optimisation false
+"""
+     rate_tuned, steps_tuned = run_navigation_benchmark(config_tmpdir, output_tmpdir,
+                                                        PETALODIR, 'PET_navigation_tuned_test',
+                                                        settings)
+     assert rate_tuned > 0
+     assert steps_tuned == pytest.approx(steps, rel=1e-3)
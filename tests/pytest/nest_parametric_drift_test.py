@@ -0,0 +1,69 @@
+import pytest
+
+import os
+import re
+import subprocess
+
+import pandas as pd
+
+
+def run_full_body_nest(config_tmpdir, output_tmpdir, PETALODIR, base_name, parametric):
+     """
+     Run the PET_full_body_nest macros, with the output file
+     and the drift of the thermal electrons changed.
+     """
+
+     macros = os.path.join(PETALODIR, 'macros')
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     init_path   = os.path.join(config_tmpdir, base_name+'.init.mac')
+
+     with open(os.path.join(macros, 'PET_full_body_nest.init.mac')) as f:
+          init_text = f.read()
+     init_text = re.sub(r'/nexus/RegisterMacro .*',
+                        '/nexus/RegisterMacro ' + config_path, init_text)
+
+     with open(os.path.join(macros, 'PET_full_body_nest.config.mac')) as f:
+          config_text = f.read()
+     config_text = re.sub(r'/petalosim/persistency/output_file .*',
+                          f'/petalosim/persistency/output_file {output_tmpdir}/{base_name}',
+                          config_text)
+     config_text += f"""
+/run/verbose 0
+/petalosim/random/per_event_seeding true
+/Actions/PetNESTStackingAction/parametric_drift {'true' if parametric else 'false'}
+"""
+
+     with open(init_path, 'w') as f:
+          f.write(init_text)
+     with open(config_path, 'w') as f:
+          f.write(config_text)
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '10', init_path]
+     subprocess.run(command, check=True, capture_output=True)
+
+     return pd.read_hdf(os.path.join(output_tmpdir, base_name+'.h5'), 'MC/charge_response')
+
+
+def test_parametric_drift_matches_tracked_drift(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     The wire charge computed with the parametric drift of the thermal
+     electrons must agree with the one obtained by tracking them.
+     """
+
+     tracked    = run_full_body_nest(config_tmpdir, output_tmpdir, PETALODIR,
+                                     'PET_full_body_nest_tracked_test', False)
+     parametric = run_full_body_nest(config_tmpdir, output_tmpdir, PETALODIR,
+                                     'PET_full_body_nest_parametric_test', True)
+
+     assert tracked   .charge.sum() > 0
+     assert parametric.charge.sum() > 0
+
+     # Same number of electrons, up to the fluctuations of the events
+     # and the electrons absorbed by the separators when tracked
+     ratio = parametric.charge.sum() / tracked.charge.sum()
+     assert 0.7 < ratio < 1.3
+
+     # Same mean drift time
+     t_tracked    = (tracked   .time_bin * tracked   .charge).sum() / tracked   .charge.sum()
+     t_parametric = (parametric.time_bin * parametric.charge).sum() / parametric.charge.sum()
+     assert t_parametric == pytest.approx(t_tracked, rel=0.2)
@@ -0,0 +1,40 @@
+import pandas as pd
+import numpy as np
+
+
+def test_parameterised_sensors_ids_and_positions(file_names_parameterised_sensors):
+     """
+     The SiPMs placed as a single parameterised volume must keep
+     the ids and the positions of the ones placed one by one.
+     """
+
+     file_pl, file_pm = file_names_parameterised_sensors
+
+     pos_pl = pd.read_hdf(file_pl, 'MC/sns_positions').set_index('sensor_id')
+     pos_pm = pd.read_hdf(file_pm, 'MC/sns_positions').set_index('sensor_id')
+
+     # Inner and external faces of 148 and 175 SiPMs in 20 rows
+     n_sensors = (148 + 175) * 20
+     assert pos_pm.index.min() >= 1000
+     assert pos_pm.index.max() <  1000 + n_sensors
+
+     common = pos_pl.index.intersection(pos_pm.index)
+     assert len(common) > 0.9 * min(len(pos_pl), len(pos_pm))
+     for coord in ['x', 'y', 'z']:
+          assert np.allclose(pos_pl.loc[common, coord],
+                             pos_pm.loc[common, coord], atol=0.01)
+
+
+def test_parameterised_sensors_response(file_names_parameterised_sensors):
+     """
+     The sensors with signal in the parameterised placement
+     must be among the ones of the ring.
+     """
+
+     file_pl, file_pm = file_names_parameterised_sensors
+
+     for filename in [file_pl, file_pm]:
+          resp = pd.read_hdf(filename, 'MC/sns_response')
+          pos  = pd.read_hdf(filename, 'MC/sns_positions')
+          assert resp.charge.sum() > 0
+          assert set(resp.sensor_id) <= set(pos.sensor_id)
@@ -0,0 +1,29 @@
+import pytest
+
+import pandas as pd
+
+
+@pytest.mark.parametrize("table", ["particles", "hits", "sns_response"])
+def test_per_event_seeding_independent_of_job_split(file_names_per_event_seeding, table):
+     """
+     Events 3-5 simulated in a job starting at event 3 must be
+     identical to the same events simulated after events 0-2.
+     """
+
+     file_full, file_split = file_names_per_event_seeding
+
+     full  = pd.read_hdf(file_full,  'MC/'+table)
+     split = pd.read_hdf(file_split, 'MC/'+table)
+
+     # Only the events with energy deposition are saved, so the
+     # stored events of the split job are the last ones of the full job
+     split_evts = split.event_id.unique()
+     full_evts  = full .event_id.unique()[-len(split_evts):]
+
+     assert len(split_evts) > 0
+
+     full  = full [full.event_id.isin(full_evts)]
+     full  = full .drop(columns='event_id').reset_index(drop=True)
+     split = split.drop(columns='event_id').reset_index(drop=True)
+
+     pd.testing.assert_frame_equal(full, split)
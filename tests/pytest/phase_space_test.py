@@ -0,0 +1,34 @@
+import os
+import pandas as pd
+import numpy as np
+
+
+def test_phase_space_file(file_names_phase_space):
+     """Check that the phase-space file contains whole records."""
+
+     psf_file, _ = file_names_phase_space
+
+     header_size = 16
+     record_size = 48
+     size = os.path.getsize(psf_file)
+     assert size > header_size
+     assert (size - header_size) % record_size == 0
+
+     with open(psf_file, 'rb') as f:
+          assert f.read(8) == b'PETPSV1\0'
+
+
+def test_phase_space_replay(file_names_phase_space):
+     """
+     Check that the primary particles of the replayed events start
+     on the capture cylinder.
+     """
+
+     _, replay_file = file_names_phase_space
+
+     particles = pd.read_hdf(replay_file, 'MC/particles')
+     primaries = particles[particles.primary == 1]
+     assert len(primaries) > 0
+
+     radius = np.sqrt(primaries.initial_x**2 + primaries.initial_y**2)
+     np.testing.assert_allclose(radius, 370., atol=1e-2)
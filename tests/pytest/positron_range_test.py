@@ -0,0 +1,26 @@
+import pandas as pd
+import numpy as np
+
+
+def test_annihilation_points_within_positron_range(file_name_positron_range):
+     """
+     Check that the gammas start from points displaced from the decay
+     vertex by less than the maximum positron range of Ga-68 (10.3 mm),
+     and that both gammas of an event start from the same point.
+     """
+
+     particles = pd.read_hdf(file_name_positron_range, 'MC/particles')
+     primaries = particles[particles.primary == 1]
+
+     assert len(primaries) > 0
+
+     dist = np.sqrt((primaries.initial_x - 10)**2 +
+                    (primaries.initial_y - 20)**2 +
+                    (primaries.initial_z - 30)**2)
+     assert np.all(dist <= 10.3 + 1e-3)
+     assert np.any(dist >  0.)
+
+     per_event = primaries.groupby('event_id')
+     assert np.all(per_event.initial_x.nunique() == 1)
+     assert np.all(per_event.initial_y.nunique() == 1)
+     assert np.all(per_event.initial_z.nunique() == 1)
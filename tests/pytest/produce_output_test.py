@@ -5,7 +5,10 @@ import subprocess
 
 
 @pytest.mark.order(1)
-def test_create_petalo_output_file_full_body(config_tmpdir, output_tmpdir, PETALODIR, base_name_full_body):
+@pytest.mark.parametrize("async_writer", [False, True], ids=["sync", "async"])
+def test_create_petalo_output_file_full_body(config_tmpdir, output_tmpdir, PETALODIR, base_name_full_body, async_writer):
+
+     base_name = base_name_full_body + ('_async' if async_writer else '')
 
      init_text = f"""
 /PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
@@ -28,9 +31,9 @@ def test_create_petalo_output_file_full_body(config_tmpdir, output_tmpdir, PETAL
 
 /nexus/RegisterPersistencyManager PetaloPersistencyManager
 
-/nexus/RegisterMacro {config_tmpdir}/{base_name_full_body}.config.mac
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
 """
-     init_path = os.path.join(config_tmpdir, base_name_full_body+'.init.mac')
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
      init_file = open(init_path,'w')
      init_file.write(init_text)
      init_file.close()
@@ -57,12 +60,13 @@ def test_create_petalo_output_file_full_body(config_tmpdir, output_tmpdir, PETAL
 
 /process/optical/processActivation Cerenkov false
 
-/petalosim/persistency/output_file {output_tmpdir}/{base_name_full_body}
+/petalosim/persistency/async_writer {async_writer}
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
 /nexus/random_seed 16062020
 
 """
 
-     config_path = os.path.join(config_tmpdir, base_name_full_body+'.config.mac')
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
      config_file = open(config_path,'w')
      config_file.write(config_text)
      config_file.close()
@@ -467,3 +471,675 @@ def test_create_petalo_output_file_phantom(config_tmpdir, output_tmpdir, PETALOD
      petalo_exe = PETALODIR + '/bin/petalo'
      command   = [petalo_exe, '-b', '-n', '10000', init_path]
      p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(7)
+def test_create_petalo_output_file_lut(config_tmpdir, output_tmpdir, PETALODIR, base_name_lut):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator LXeScintillationGenerator
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name_lut}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name_lut+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/lut true
+/Geometry/FullRingInfinity/lut_binning 2. cm
+/Geometry/FullRingInfinity/events_per_point 2
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/visibility true
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/LXeScintGenerator/region LUT
+/Generator/LXeScintGenerator/nphotons 1000
+
+/petalosim/persistency/lut true
+/petalosim/persistency/output_file {output_tmpdir}/{base_name_lut}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name_lut+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '20', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(8)
+@pytest.mark.parametrize("ray_tracing", [False, True], ids=["geant4", "ray_tracing"])
+def test_create_petalo_output_file_optical_transport(config_tmpdir, output_tmpdir, PETALODIR, base_name_optical_transport, ray_tracing):
+
+     base_name = base_name_optical_transport
+     stacking  = ''
+     if ray_tracing:
+          base_name = base_name + '_rt'
+          stacking  = '/nexus/RegisterStackingAction PetRayTracingStackingAction'
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator LXeScintillationGenerator
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+{stacking}
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 2
+/Geometry/FullRingInfinity/specific_vertex 0. 180. 0. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/visibility true
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/LXeScintGenerator/region AD_HOC
+/Generator/LXeScintGenerator/nphotons 20000
+
+/petalosim/persistency/lut true
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '4', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(9)
+def test_create_petalo_output_file_phase_space(config_tmpdir, output_tmpdir, PETALODIR, base_name_phase_space):
+
+     # Capture the particles leaving the phantom and then replay them
+     # without the phantom
+     for replay in [False, True]:
+
+          base_name = base_name_phase_space + ('_replay' if replay else '_capture')
+          generator = 'PhaseSpaceGenerator' if replay else 'Back2backGammas'
+          stepping  = '' if replay else '/nexus/RegisterSteppingAction PetPhaseSpaceSteppingAction'
+          n_events  = '20' if replay else '100'
+
+          if replay:
+               source = f"""
+/Generator/PhaseSpace/file {output_tmpdir}/{base_name_phase_space}.psf
+"""
+          else:
+               source = f"""
+/Geometry/FullRingInfinity/phantom true
+/Generator/Back2back/region JPHANTOM
+/Actions/PetPhaseSpaceSteppingAction/file {output_tmpdir}/{base_name_phase_space}.psf
+/Actions/PetPhaseSpaceSteppingAction/radius 370. mm
+"""
+
+          init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4RadioactiveDecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator {generator}
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction DefaultTrackingAction
+{stepping}
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+          init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+          init_file = open(init_path,'w')
+          init_file.write(init_text)
+          init_file.close()
+
+          config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 380. mm
+/Geometry/FullRingInfinity/sipm_rows 278
+/Geometry/FullRingInfinity/instrumented_faces 1
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/visibility true
+/Geometry/SiPMpet/size 6. mm
+{source}
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+
+"""
+
+          config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+          config_file = open(config_path,'w')
+          config_file.write(config_text)
+          config_file.close()
+
+          my_env    = os.environ
+          petalo_exe = PETALODIR + '/bin/petalo'
+          command   = [petalo_exe, '-b', '-n', n_events, init_path]
+          p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(10)
+def test_create_petalo_output_file_sensitivity(config_tmpdir, output_tmpdir, PETALODIR, base_name_sensitivity):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator SensMap
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name_sensitivity}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name_sensitivity+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/sensitivity true
+/Geometry/FullRingInfinity/sensitivity_binning 2. cm
+/Geometry/FullRingInfinity/events_per_point 2
+/Geometry/FullRingInfinity/job_id 1
+/Geometry/FullRingInfinity/num_jobs 2
+/Geometry/FullRingInfinity/sens_x_min -20. mm
+/Geometry/FullRingInfinity/sens_x_max  20. mm
+/Geometry/FullRingInfinity/sens_y_min -20. mm
+/Geometry/FullRingInfinity/sens_y_max  20. mm
+/Geometry/FullRingInfinity/sens_z_min -20. mm
+/Geometry/FullRingInfinity/sens_z_max  20. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/SensMap/num_gammas 1
+
+/Actions/PetaloEventAction/min_energy 0.95 MeV
+
+/petalosim/persistency/sensitivity true
+/petalosim/persistency/output_file {output_tmpdir}/{base_name_sensitivity}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name_sensitivity+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     # More events than the 4 points x 2 events of the slice of the job,
+     # to check that the extra ones are not counted in the map
+     command   = [petalo_exe, '-b', '-n', '12', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(11)
+def test_create_petalo_output_file_positron_range(config_tmpdir, output_tmpdir, PETALODIR, base_name_positron_range):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name_positron_range}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name_positron_range+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/specific_vertex 10. 20. 30. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region AD_HOC
+/Generator/Back2back/isotope Ga68
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name_positron_range}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name_positron_range+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '20', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(12)
+@pytest.mark.parametrize("start_id, nevents", [(0, 6), (3, 3)], ids=["full", "split"])
+@pytest.mark.parametrize("generator", ["Back2backGammas", "SingleParticleGenerator"])
+def test_create_petalo_output_file_per_event_seeding(config_tmpdir, output_tmpdir, PETALODIR, base_name_per_event_seeding, start_id, nevents, generator):
+
+     # The nexus SingleParticleGenerator does not know about the
+     # per-event seeding: the engine is reseeded before any generator
+     base_name = f'{base_name_per_event_seeding}_{generator}_{start_id}'
+     if generator == 'Back2backGammas':
+          generator_config = '/Generator/Back2back/region AD_HOC'
+     else:
+          # Electrons starting in the LXe, to deposit energy in all events
+          generator_config = """
+/Geometry/FullRingInfinity/specific_vertex 0. 180. 0. mm
+/Generator/SingleParticle/particle e-
+/Generator/SingleParticle/min_energy 0.1 MeV
+/Generator/SingleParticle/max_energy 0.5 MeV
+/Generator/SingleParticle/region AD_HOC
+"""
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator {generator}
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/specific_vertex 0. 0. 0. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+{generator_config}
+
+/petalosim/random/per_event_seeding true
+/petalosim/persistency/start_id {start_id}
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', str(nevents), init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(13)
+def test_create_petalo_output_file_profile(config_tmpdir, output_tmpdir, PETALODIR, base_name_profile):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetProfilingTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name_profile}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name_profile+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/specific_vertex 0. 0. 0. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region AD_HOC
+
+/process/optical/processActivation Cerenkov false
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name_profile}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name_profile+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '5', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(14)
+@pytest.mark.parametrize("parameterised", [False, True], ids=["placement", "parameterised"])
+def test_create_petalo_output_file_parameterised_sensors(config_tmpdir, output_tmpdir, PETALODIR, base_name_parameterised_sensors, parameterised):
+
+     base_name = base_name_parameterised_sensors
+     if parameterised:
+          base_name = base_name + '_param'
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 2
+/Geometry/FullRingInfinity/parameterised_sensors {str(parameterised).lower()}
+/Geometry/FullRingInfinity/specific_vertex 0. 0. 0. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region AD_HOC
+
+/process/optical/processActivation Cerenkov false
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '5', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
+
+
+@pytest.mark.order(15)
+def test_create_petalo_output_file_sensitivity_slice(config_tmpdir, output_tmpdir, PETALODIR, base_name_sensitivity_slice):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator SensMap
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name_sensitivity_slice}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name_sensitivity_slice+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/sensitivity true
+/Geometry/FullRingInfinity/sensitivity_binning 2. cm
+/Geometry/FullRingInfinity/events_per_point 2
+/Geometry/FullRingInfinity/job_id 0
+/Geometry/FullRingInfinity/num_jobs 2
+/Geometry/FullRingInfinity/sens_x_min -20. mm
+/Geometry/FullRingInfinity/sens_x_max  20. mm
+/Geometry/FullRingInfinity/sens_y_min -20. mm
+/Geometry/FullRingInfinity/sens_y_max  20. mm
+/Geometry/FullRingInfinity/sens_z_min -20. mm
+/Geometry/FullRingInfinity/sens_z_max  20. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/SensMap/num_gammas 1
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name_sensitivity_slice}
+/nexus/random_seed 16062020
+
+"""
+
+     config_path = os.path.join(config_tmpdir, base_name_sensitivity_slice+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     # The slice of the job has 4 points of 2 events:
+     # the events beyond the first 8 must not be simulated
+     my_env    = os.environ
+     petalo_exe = PETALODIR + '/bin/petalo'
+     command   = [petalo_exe, '-b', '-n', '12', init_path]
+     p         = subprocess.run(command, check=True, env=my_env)
@@ -0,0 +1,47 @@
+import pandas as pd
+import numpy as np
+
+
+def test_profile_table(file_name_profile):
+     """
+     Check that the profile of each saved event has the tracks
+     of the species produced and that the number of tracks of the
+     particles with trajectory matches the particles table.
+     """
+
+     profile   = pd.read_hdf(file_name_profile, 'MC/profile')
+     particles = pd.read_hdf(file_name_profile, 'MC/particles')
+
+     columns = ['event_id', 'particle_name', 'n_tracks', 'n_steps', 'wall_time']
+     assert list(profile.columns) == columns
+
+     assert set(profile.event_id) == set(particles.event_id)
+
+     names = profile.particle_name
+     assert set(names) <= {'gamma', 'e-', 'e+', 'opticalphoton',
+                           'thermalelectron', 'other'}
+     assert 'opticalphoton' in set(names)
+
+     assert np.all(profile.n_tracks > 0)
+     assert np.all(profile.n_steps   > 0)
+     assert np.all(profile.wall_time >= 0)
+
+     # Optical photons and thermal electrons are not stored as particles
+     stored   = ~names.isin(['opticalphoton', 'thermalelectron'])
+     n_tracks = profile[stored].groupby('event_id').n_tracks.sum()
+     n_parts  = particles.groupby('event_id').particle_id.count()
+     pd.testing.assert_series_equal(n_tracks, n_parts, check_names=False,
+                                    check_dtype=False)
+
+
+def test_profile_run_summary(file_name_profile):
+     """
+     Check that the peak memory and hits-collection
+     sizes are saved in the configuration table.
+     """
+
+     conf = pd.read_hdf(file_name_profile, 'MC/configuration')
+     keys = conf.param_key
+
+     assert 'profile_peak_rss' in set(keys)
+     assert keys.str.startswith('profile_peak_hits_').any()
@@ -0,0 +1,85 @@
+import pytest
+
+import os
+import re
+import subprocess
+
+
+def test_stepping_profile_times_optical_photons(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     Optical photons in LXe take few steps each, so their steps must
+     be timed from the start of the track. The profile of each run is
+     printed at its end, with a non-zero time for Transportation.
+     """
+
+     base_name = 'PET_stepping_profile_test'
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator LXeScintillationGenerator
+
+### ACTIONS
+/nexus/RegisterRunAction PetProfilingRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetProfilingTrackingAction
+/nexus/RegisterSteppingAction PetProfilingSteppingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/specific_vertex 0. 180. 0. mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/LXeScintGenerator/region AD_HOC
+/Generator/LXeScintGenerator/nphotons 1000
+
+/Actions/PetProfilingSteppingAction/top 50
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+"""
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '5', init_path]
+     p = subprocess.run(command, check=True, capture_output=True, text=True)
+
+     # Printed once, at the end of the run
+     assert p.stdout.count('Stepping profile:') == 1
+     summary = p.stdout[p.stdout.index('Stepping profile:'):]
+     assert summary.index('Stepping profile:') < summary.index('### Run 0 end.')
+
+     # Rows: volume, process, steps, length, time, time fraction
+     rows = re.findall(r'^\s*(\S+)\s+(\S+)\s+(\d+)\s+(\S+)\s+(\S+)\s+(\S+)\s*$',
+                       summary, re.MULTILINE)
+     transport = [r for r in rows if r[1] == 'Transportation']
+     assert len(transport) > 0
+     assert sum(float(r[4]) for r in transport) > 0
+     assert all(float(r[4]) > 0 for r in rows)
@@ -0,0 +1,41 @@
+import pandas as pd
+import numpy as np
+
+
+def test_ray_tracing_matches_geant4_tracking(file_names_optical_transport):
+     """
+     Compare the response of the sensors to the same scintillation
+     photons transported by Geant4 and by the analytic ray tracer.
+     """
+
+     file_g4, file_rt = file_names_optical_transport
+
+     lut_g4 = pd.read_hdf(file_g4, 'MC/lut')
+     lut_rt = pd.read_hdf(file_rt, 'MC/lut')
+
+     # Detection probability of the whole ring
+     prob_g4 = lut_g4.probability.sum()
+     prob_rt = lut_rt.probability.sum()
+     assert prob_g4 > 0
+     assert np.isclose(prob_rt, prob_g4, rtol=0.1)
+
+     # Mean arrival time of the detected photons
+     time_g4 = np.average(lut_g4.mean_time, weights=lut_g4.counts)
+     time_rt = np.average(lut_rt.mean_time, weights=lut_rt.counts)
+     assert np.isclose(time_rt, time_g4, rtol=0.1)
+
+
+def test_ray_tracing_sensor_positions(file_names_optical_transport):
+     """The ray tracer must give the same positions to the same sensor ids."""
+
+     file_g4, file_rt = file_names_optical_transport
+
+     pos_g4 = pd.read_hdf(file_g4, 'MC/sns_positions').set_index('sensor_id')
+     pos_rt = pd.read_hdf(file_rt, 'MC/sns_positions').set_index('sensor_id')
+
+     common = pos_g4.index.intersection(pos_rt.index)
+     assert len(common) > 0
+     for coord in ['x', 'y', 'z']:
+          assert np.allclose(pos_g4.loc[common, coord],
+                             pos_rt.loc[common, coord], atol=0.01)
+
@@ -0,0 +1,68 @@
+import pandas as pd
+import tables as tb
+import numpy as np
+
+
+def test_sensitivity_structure(file_name_sensitivity):
+     """Check that in sensitivity mode only the sensitivity map is saved."""
+
+     with tb.open_file(file_name_sensitivity) as h5out:
+
+         assert 'sensitivity_map' in h5out.root.MC
+         assert len(h5out.root.MC.hits)      == 0
+         assert len(h5out.root.MC.particles) == 0
+
+         scolumns = h5out.root.MC.sensitivity_map.colnames
+         assert 'point_id'       in scolumns
+         assert 'x'              in scolumns
+         assert 'y'              in scolumns
+         assert 'z'              in scolumns
+         assert 'n_generated'    in scolumns
+         assert 'n_selected'     in scolumns
+         assert 'n_coincidences' in scolumns
+
+
+def test_sensitivity_counts(file_name_sensitivity):
+     """
+     Check that the points are the second half of the map and that
+     the number of events of each point is consistent.
+     """
+
+     smap = pd.read_hdf(file_name_sensitivity, 'MC/sensitivity_map')
+
+     # 8 points in the map, of which job 1 of 2 takes the last 4.
+     # The job runs 12 events, but only events_per_point = 2
+     # must be counted for each point
+     assert np.all(smap.point_id == np.arange(4, 8))
+     assert np.all(smap.n_generated == 2)
+     assert smap.n_generated.sum() == 8
+     assert np.all(smap.x == 0)
+     assert np.all(smap.n_selected     <= smap.n_generated)
+     assert np.all(smap.n_coincidences <= smap.n_selected)
+
+
+def test_sensitivity_slice(file_name_sensitivity_slice, file_name_sensitivity):
+     """
+     Check that a job asked for more events than its slice of the map
+     holds simulates only the events of its points, and that these points
+     are not those of the other job.
+     """
+
+     particles = pd.read_hdf(file_name_sensitivity_slice, 'MC/particles')
+     conf      = pd.read_hdf(file_name_sensitivity_slice, 'MC/configuration')
+     smap      = pd.read_hdf(file_name_sensitivity, 'MC/sensitivity_map')
+
+     # 4 points of 2 events: the last 4 events of the 12 must be aborted
+     assert particles.event_id.max() < 8
+     saved = conf[conf.param_key == 'saved_events'].param_value.astype(int)
+     assert saved.iloc[0] <= 8
+
+     primaries = particles[particles.primary == 1]
+     vertices  = primaries.groupby('event_id')[['initial_x', 'initial_y', 'initial_z']].first()
+     points    = vertices.round(3).value_counts()
+     assert len(points) <= 4
+     assert np.all(points <= 2)
+
+     other = set(zip(smap.x.round(3), smap.y.round(3), smap.z.round(3)))
+     for point in points.index:
+          assert point not in other
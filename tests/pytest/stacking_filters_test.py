@@ -0,0 +1,111 @@
+import pytest
+
+import os
+import re
+import subprocess
+
+import pandas as pd
+
+
+def run_stacking_filters(config_tmpdir, output_tmpdir, PETALODIR, base_name, rules):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+/nexus/RegisterStackingAction PetaloStackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region CENTER
+
+{rules}
+
+/petalosim/random/per_event_seeding true
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+"""
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '5', init_path]
+     p = subprocess.run(command, check=True, capture_output=True, text=True)
+
+     sns = pd.read_hdf(os.path.join(output_tmpdir, base_name+'.h5'), 'MC/sns_response')
+     charge = sns.groupby('event_id').charge.sum()
+     return p.stdout, charge
+
+
+def test_stacking_filters(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     Killing the scintillation photons created in ACTIVE, or keeping
+     only the Cherenkov ones, must leave only a small fraction of the
+     detected photons. The gammas of each event are the same in all the
+     runs, since the random engine is reseeded at each event and the
+     optical photons are only tracked after them.
+     """
+
+     _, charge = run_stacking_filters(config_tmpdir, output_tmpdir, PETALODIR,
+                                      'PET_stacking_all_test', '')
+     assert charge.sum() > 0
+
+     kill_rule = 'volume:ACTIVE process:Scintillation'
+     out, charge_kill = run_stacking_filters(config_tmpdir, output_tmpdir, PETALODIR,
+                                             'PET_stacking_kill_test',
+                                             '/Actions/PetaloStackingAction/kill ' + kill_rule)
+     killed = re.search(r"killed by rule '" + kill_rule + r"': (\d+)\n"
+                        r"((?:\[PetaloStackingAction\]   in .*\n)*)", out)
+     assert killed and int(killed.group(1)) > 0
+
+     # The rule only kills photons created in ACTIVE, and the counts
+     # per volume add up to the total
+     per_volume = dict(re.findall(r'\]   in (\S+): (\d+)', killed.group(2)))
+     assert list(per_volume) == ['ACTIVE']
+     assert int(per_volume['ACTIVE']) == int(killed.group(1))
+
+     keep_rule = 'volume:ACTIVE process:Cerenkov'
+     out, charge_keep = run_stacking_filters(config_tmpdir, output_tmpdir, PETALODIR,
+                                             'PET_stacking_keep_test',
+                                             '/Actions/PetaloStackingAction/keep ' + keep_rule)
+     not_kept = re.search(r'killed by the keep rules: (\d+)', out)
+     assert not_kept and int(not_kept.group(1)) >= int(killed.group(1))
+
+     for filtered in (charge_kill, charge_keep):
+          common = filtered.index.intersection(charge.index)
+          assert len(common) > 0
+          assert (filtered[common] <= charge[common]).all()
+          assert filtered.sum() < 0.2 * charge.sum()
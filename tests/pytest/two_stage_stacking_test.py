@@ -0,0 +1,115 @@
+import pytest
+
+import os
+import re
+import subprocess
+
+import numpy as np
+import pandas as pd
+
+
+def run_two_stage(config_tmpdir, output_tmpdir, PETALODIR, base_name, min_energy):
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction PetaloTrackingAction
+/nexus/RegisterStackingAction PetaloStackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     # The reference run keeps the default window, which accepts all the
+     # events: a zero threshold is outside the range of the command
+     window = '' if min_energy is None else f'/Actions/PetaloEventAction/min_energy {min_energy} MeV'
+
+     config_text = f"""
+/run/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region CENTER
+
+{window}
+
+/petalosim/random/per_event_seeding true
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+"""
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '10', init_path]
+     p = subprocess.run(command, check=True, capture_output=True, text=True)
+
+     file_name = os.path.join(output_tmpdir, base_name+'.h5')
+     particles = pd.read_hdf(file_name, 'MC/particles')
+     sns       = pd.read_hdf(file_name, 'MC/sns_response')
+
+     # Saved events are numbered consecutively: they are identified
+     # across runs by the momentum of their first primary gamma
+     primaries = particles[particles.primary == 1].groupby('event_id').first()
+     keys = primaries[['initial_momentum_x', 'initial_momentum_y', 'initial_momentum_z']]
+     keys = keys.round(6).apply(tuple, axis=1)
+
+     rejected = re.search(r'not tracked in (\d+) events', p.stdout)
+     assert rejected
+
+     return keys, sns, int(rejected.group(1))
+
+
+def test_two_stage_stacking(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     With a window in the event action, the optical photons of the events
+     outside it are not tracked and the events produce no sensor response,
+     while the accepted events give the same sensor response as when all
+     the events are accepted.
+     """
+
+     keys_all, sns_all, rejected_all = run_two_stage(config_tmpdir, output_tmpdir, PETALODIR,
+                                                     'PET_two_stage_all_test', None)
+     keys_win, sns_win, rejected_win = run_two_stage(config_tmpdir, output_tmpdir, PETALODIR,
+                                                     'PET_two_stage_window_test', 0.4)
+
+     # The events are a subset, and the missing ones were not tracked
+     assert set(keys_win) <= set(keys_all)
+     assert len(keys_win) < len(keys_all)
+     assert rejected_win - rejected_all == len(keys_all) - len(keys_win)
+
+     # Only the accepted events have a sensor response
+     assert set(sns_win.event_id.unique()) <= set(keys_win.index)
+
+     ids_all = pd.Series(keys_all.index, index=keys_all.values)
+     for evt, key in keys_win.items():
+          r_win = sns_win[sns_win.event_id == evt ]     .drop(columns='event_id')
+          r_all = sns_all[sns_all.event_id == ids_all[key]].drop(columns='event_id')
+          pd.testing.assert_frame_equal(r_win.reset_index(drop=True),
+                                        r_all.reset_index(drop=True))
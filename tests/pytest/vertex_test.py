@@ -1,6 +1,7 @@
 import pytest
 import os
 
+import numpy  as np
 import pandas as pd
 
 def test_vertices_are_generated_in_phantom(file_name_phantom):
@@ -15,3 +16,74 @@ def test_vertices_are_generated_in_phantom(file_name_phantom):
                        'SPHERE4', 'SPHERE5']
 
     assert all(elem in correct_volumes for elem in volumes)
+
+
+def jaszczak_rods(r, n):
+    """
+    Number of rods of radius r in sector n of the Jaszczak phantom,
+    following the lattice of JaszczakPhantom::BuildRods().
+    """
+    cylinder_r = 216 / 2
+    gap = 12. if n == 0 else 14.4
+    dx  = gap * np.cos(np.pi/6) + r * np.sqrt(3)
+    dy  = gap * np.sin(np.pi/6) + r
+
+    n_rods = 0
+    a      = 0
+    did_b  = True
+    while did_b:
+        did_b = False
+        b     = 0
+        while True:
+            x = (2 * a + b)     * 2 * r + dx
+            y = b * np.sqrt(3)  * 2 * r + dy
+            if (a, b) in ((5, 11), (11, 5)):
+                break
+            if np.sqrt(x**2 + y**2) + r + 0.1 >= cylinder_r:
+                break
+            n_rods += 1
+            b      += 1
+            did_b   = True
+        a += 1
+    return n_rods
+
+
+def test_vertices_follow_phantom_activities(file_name_phantom):
+    """
+    Check that each compartment of the phantom receives a fraction of
+    the vertices proportional to its activity times its volume.
+    """
+
+    particles = pd.read_hdf(file_name_phantom, 'MC/particles')
+    primaries = particles[particles.primary == 1]
+    # The two gammas of an event share the vertex
+    vertices  = primaries.groupby('event_id').initial_volume.first()
+
+    # Default activities of JaszczakPhantom
+    bckg_activity, hot_activity = 1, 4
+
+    sphere_d = [9.5, 12.7, 15.9, 19.1, 25.4, 31.8]
+    rod_d    = [3.2,  4.8,  6.4,  7.9,  9.5, 11.1]
+    rod_h    = 88.
+
+    weights = {}
+    for n, d in enumerate(sphere_d):
+        weights[f'SPHERE{n}'] = 4/3 * np.pi * (d/2)**3
+    for n, d in enumerate(rod_d):
+        weights[f'ROD{n}'] = jaszczak_rods(d/2, n) * np.pi * (d/2)**2 * rod_h
+
+    bckg_volume = np.pi * (216/2)**2 * 186 - sum(weights.values())
+    for name in weights:
+        weights[name] *= hot_activity
+    weights['WATER_BCKG'] = bckg_activity * bckg_volume
+
+    total = sum(weights.values())
+    n_vtx = len(vertices)
+    assert n_vtx > 0
+
+    counts = vertices.value_counts()
+    for name, w in weights.items():
+        expected = w / total
+        observed = counts.get(name, 0) / n_vtx
+        sigma    = np.sqrt(expected * (1 - expected) / n_vtx)
+        assert observed == pytest.approx(expected, abs=5*sigma + 0.005)
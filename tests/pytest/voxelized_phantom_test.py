@@ -0,0 +1,99 @@
+import os
+import subprocess
+
+import numpy  as np
+import pandas as pd
+
+
+def test_voxelized_phantom_vertices(config_tmpdir, output_tmpdir, PETALODIR):
+     """
+     Check that the vertices of a voxelized phantom are generated
+     only in the voxels with activity.
+     """
+
+     base_name  = 'PET_voxelized_phantom_test'
+     nx, ny, nz = 6, 4, 3
+     voxel      = 5. # mm
+
+     # Raw float32 maps, x running fastest
+     attenuation = np.full((nz, ny, nx), 0.096, dtype=np.float32)
+     iz, iy, ix  = np.indices((nz, ny, nx))
+     activity    = np.where((ix + iy + iz) % 2 == 0, 1. + iz, 0.).astype(np.float32)
+
+     attenuation_path = os.path.join(config_tmpdir, base_name+'.attenuation.raw')
+     activity_path    = os.path.join(config_tmpdir, base_name+'.activity.raw')
+     attenuation.tofile(attenuation_path)
+     activity   .tofile(activity_path)
+
+     init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics PetaloPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+### GEOMETRY
+/nexus/RegisterGeometry FullRingInfinity
+
+### GENERATOR
+/nexus/RegisterGenerator Back2backGammas
+
+### ACTIONS
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterEventAction PetaloEventAction
+/nexus/RegisterTrackingAction DefaultTrackingAction
+
+/nexus/RegisterPersistencyManager PetaloPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+     init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+     init_file = open(init_path,'w')
+     init_file.write(init_text)
+     init_file.close()
+
+     config_text = f"""
+/run/verbose 0
+/event/verbose 0
+/tracking/verbose 0
+
+/Geometry/FullRingInfinity/depth 3. cm
+/Geometry/FullRingInfinity/sipm_pitch 7. mm
+/Geometry/FullRingInfinity/inner_radius 165. mm
+/Geometry/FullRingInfinity/sipm_rows 20
+/Geometry/FullRingInfinity/instrumented_faces 1
+/Geometry/FullRingInfinity/voxelized_phantom true
+
+/Geometry/VoxelizedPhantom/attenuation_file {attenuation_path}
+/Geometry/VoxelizedPhantom/activity_file {activity_path}
+/Geometry/VoxelizedPhantom/voxels {nx} {ny} {nz}
+/Geometry/VoxelizedPhantom/voxel_size {voxel} {voxel} {voxel} mm
+
+/Geometry/SiPMpet/efficiency 0.2
+/Geometry/SiPMpet/size 6. mm
+
+/Generator/Back2back/region VPHANTOM
+
+/petalosim/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 16062020
+"""
+     config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+     config_file = open(config_path,'w')
+     config_file.write(config_text)
+     config_file.close()
+
+     command = [PETALODIR + '/bin/petalo', '-b', '-n', '500', init_path]
+     subprocess.run(command, check=True, capture_output=True)
+
+     particles = pd.read_hdf(os.path.join(output_tmpdir, base_name+'.h5'), 'MC/particles')
+     primaries = particles[particles.primary == 1]
+     assert len(primaries) > 0
+
+     # The phantom is centred at the origin
+     vx = np.floor(primaries.initial_x.values / voxel + nx / 2).astype(int)
+     vy = np.floor(primaries.initial_y.values / voxel + ny / 2).astype(int)
+     vz = np.floor(primaries.initial_z.values / voxel + nz / 2).astype(int)
+
+     assert np.all((vx >= 0) & (vx < nx))
+     assert np.all((vy >= 0) & (vy < ny))
+     assert np.all((vz >= 0) & (vz < nz))
+     assert np.all(activity[vz, vy, vx] > 0)